@@ -0,0 +1,339 @@
+/*
+  ==============================================================================
+
+    BiquadCascade.cpp
+    2차 IIR 직렬 연결 구현
+
+  ==============================================================================
+*/
+
+#include "BiquadCascade.h"
+#include <cmath>
+#include <complex>
+#include <algorithm>
+#include <array>
+
+namespace
+{
+    // low-shelf 코너 주파수 (약 1.4옥타브 간격): 등청감 곡선의 저역 기울기를 이 단들의 합으로 근사
+    constexpr std::array<double, BiquadCascade::numLowShelves> shelfCornerFrequencies { 35.0, 90.0, 230.0, 600.0 };
+
+    // 맞춤 반복 횟수, 단 gain 범위, 이웃 단끼리 gain이 크게 엇갈리지 않도록 하는 정규화 가중치
+    constexpr int fitIterations = 8;
+    constexpr double maxShelfGainDB = 24.0;
+    constexpr double fitRegularisation = 1.0e-3;
+
+    // RBJ cookbook low-shelf (shelf slope 1), a0로 정규화한 계수 5개
+    void makeLowShelf(double sampleRate, double cornerHz, double gainDB, float* destination)
+    {
+        const double A = std::pow(10.0, gainDB / 40.0);
+        const double w0 = 2.0 * juce::MathConstants<double>::pi * cornerHz / sampleRate;
+        const double cosw = std::cos(w0);
+        const double alpha = std::sin(w0) / 2.0 * std::sqrt(2.0);
+        const double beta = 2.0 * std::sqrt(A) * alpha;
+
+        const double b0 = A * ((A + 1.0) - (A - 1.0) * cosw + beta);
+        const double b1 = 2.0 * A * ((A - 1.0) - (A + 1.0) * cosw);
+        const double b2 = A * ((A + 1.0) - (A - 1.0) * cosw - beta);
+        const double a0 = (A + 1.0) + (A - 1.0) * cosw + beta;
+        const double a1 = -2.0 * ((A - 1.0) + (A + 1.0) * cosw);
+        const double a2 = (A + 1.0) + (A - 1.0) * cosw - beta;
+
+        destination[0] = static_cast<float>(b0 / a0);
+        destination[1] = static_cast<float>(b1 / a0);
+        destination[2] = static_cast<float>(b2 / a0);
+        destination[3] = static_cast<float>(a1 / a0);
+        destination[4] = static_cast<float>(a2 / a0);
+    }
+
+    void makeShelves(double sampleRate, const std::array<double, BiquadCascade::numLowShelves>& gainsDB, float* sections)
+    {
+        for (size_t i = 0; i < shelfCornerFrequencies.size(); ++i)
+            makeLowShelf(sampleRate, shelfCornerFrequencies[i], gainsDB[i],
+                         sections + i * BiquadCascade::coefficientsPerSection);
+    }
+
+    // 대칭 양의 정부호 선형 방정식 (가우스 소거, 크기가 작으므로 피벗 없이)
+    template <size_t size>
+    std::array<double, size> solve(std::array<std::array<double, size>, size> matrix, std::array<double, size> vector)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            for (size_t r = i + 1; r < size; ++r)
+            {
+                const double factor = matrix[r][i] / matrix[i][i];
+
+                for (size_t c = i; c < size; ++c)
+                    matrix[r][c] -= factor * matrix[i][c];
+
+                vector[r] -= factor * vector[i];
+            }
+        }
+
+        std::array<double, size> result {};
+        for (size_t i = size; i-- > 0;)
+        {
+            double sum = vector[i];
+            for (size_t c = i + 1; c < size; ++c)
+                sum -= matrix[i][c] * result[c];
+
+            result[i] = sum / matrix[i][i];
+        }
+
+        return result;
+    }
+}
+
+BiquadCascade::BiquadCascade()
+{
+}
+
+BiquadCascade::~BiquadCascade()
+{
+}
+
+void BiquadCascade::fitLowShelves(const float* frequencies, const float* gainsDB, int numPoints,
+                                  double sampleRate, double crossoverHz, float* sections)
+{
+    constexpr size_t numShelves = numLowShelves;
+    using Gains = std::array<double, numShelves>;
+
+    // 목표: crossover 아래는 주어진 곡선, 위는 0 dB (나이퀴스트 근처 점은 제외)
+    jassert(numPoints <= maxFitPoints);
+    std::array<double, maxFitPoints> fitFrequencies, targets;
+    size_t numFitPoints = 0;
+
+    for (int i = 0; i < numPoints && numFitPoints < fitFrequencies.size(); ++i)
+    {
+        if (frequencies[i] >= sampleRate * 0.45)
+            continue;
+
+        fitFrequencies[numFitPoints] = frequencies[i];
+        targets[numFitPoints] = frequencies[i] <= crossoverHz ? gainsDB[i] : 0.0;
+        ++numFitPoints;
+    }
+
+    // shelf의 dB 응답은 gain에 거의 선형이므로 가우스-뉴턴 몇 번이면 수렴
+    Gains gains {};
+    std::array<double, maxFitPoints> residuals;
+    std::array<Gains, maxFitPoints> jacobian;
+
+    for (int iteration = 0; iteration < fitIterations; ++iteration)
+    {
+        makeShelves(sampleRate, gains, sections);
+
+        for (size_t p = 0; p < numFitPoints; ++p)
+            residuals[p] = targets[p] - getMagnitudeDB(sections, numLowShelves, fitFrequencies[p], sampleRate);
+
+        // 수치 미분: 전체 dB 응답은 단별 dB의 합이므로 단 하나만 gain을 조금 바꿔 비교
+        for (size_t s = 0; s < numShelves; ++s)
+        {
+            constexpr double step = 0.01;
+            std::array<float, coefficientsPerSection> current, shifted;
+            makeLowShelf(sampleRate, shelfCornerFrequencies[s], gains[s], current.data());
+            makeLowShelf(sampleRate, shelfCornerFrequencies[s], gains[s] + step, shifted.data());
+
+            for (size_t p = 0; p < numFitPoints; ++p)
+                jacobian[p][s] = (getMagnitudeDB(shifted.data(), 1, fitFrequencies[p], sampleRate)
+                                - getMagnitudeDB(current.data(), 1, fitFrequencies[p], sampleRate)) / step;
+        }
+
+        // (J^T J + rI) dx = J^T r
+        std::array<Gains, numShelves> normal {};
+        Gains rhs {};
+
+        for (size_t p = 0; p < numFitPoints; ++p)
+        {
+            for (size_t r = 0; r < numShelves; ++r)
+            {
+                rhs[r] += jacobian[p][r] * residuals[p];
+
+                for (size_t c = 0; c < numShelves; ++c)
+                    normal[r][c] += jacobian[p][r] * jacobian[p][c];
+            }
+        }
+
+        for (size_t r = 0; r < numShelves; ++r)
+            normal[r][r] += fitRegularisation * static_cast<double>(numFitPoints);
+
+        const auto delta = solve(normal, rhs);
+
+        for (size_t s = 0; s < numShelves; ++s)
+            gains[s] = juce::jlimit(-maxShelfGainDB, maxShelfGainDB, gains[s] + delta[s]);
+    }
+
+    makeShelves(sampleRate, gains, sections);
+}
+
+float BiquadCascade::getMagnitudeDB(const std::vector<float>& sections, double frequency, double sampleRate)
+{
+    return getMagnitudeDB(sections.data(), static_cast<int>(sections.size()) / coefficientsPerSection, frequency, sampleRate);
+}
+
+float BiquadCascade::getMagnitudeDB(const float* sections, int numSections, double frequency, double sampleRate)
+{
+    const auto z1 = std::polar(1.0, -2.0 * juce::MathConstants<double>::pi * frequency / sampleRate);
+    const auto z2 = z1 * z1;
+    std::complex<double> response(1.0);
+
+    for (int i = 0; i < numSections; ++i)
+    {
+        const auto* c = sections + i * coefficientsPerSection;
+        response *= (static_cast<double>(c[0]) + static_cast<double>(c[1]) * z1 + static_cast<double>(c[2]) * z2)
+                  / (1.0 + static_cast<double>(c[3]) * z1 + static_cast<double>(c[4]) * z2);
+    }
+
+    return juce::Decibels::gainToDecibels(static_cast<float>(std::abs(response)), -200.0f);
+}
+
+void BiquadCascade::prepare(int maximumSections, int channels)
+{
+    maxSections = maximumSections;
+    numChannels = channels;
+    numSections = 0;
+    targetSections = 0;
+    rampLength = 0;
+    rampSamplesRemaining = 0;
+
+    coefficients.assign(static_cast<size_t>(maxSections * coefficientsPerSection), 0.0f);
+    targetCoefficients.assign(coefficients.size(), 0.0f);
+    rampCoefficients.assign(coefficients.size(), 0.0f);
+    states.assign(static_cast<size_t>(numChannels * maxSections * 2), 0.0);
+}
+
+void BiquadCascade::reset()
+{
+    std::fill(states.begin(), states.end(), 0.0);
+}
+
+void BiquadCascade::setSections(const std::vector<float>& newSections, int rampSamples)
+{
+    const int newCount = juce::jmin(static_cast<int>(newSections.size()) / coefficientsPerSection, maxSections);
+
+    // 램프 도중이면 현재 섞인 계수에서 다시 시작
+    if (rampSamplesRemaining > 0)
+    {
+        blendCoefficients(1.0f - static_cast<float>(rampSamplesRemaining) / static_cast<float>(rampLength));
+        coefficients = rampCoefficients;
+    }
+
+    // 쓰지 않는 단은 통과 단 (b0 = 1)으로 채워 단 수가 달라도 같은 자리끼리 보간
+    for (int i = 0; i < maxSections; ++i)
+    {
+        float* section = targetCoefficients.data() + i * coefficientsPerSection;
+        std::fill(section, section + coefficientsPerSection, 0.0f);
+
+        if (i < newCount)
+            std::copy(newSections.begin() + i * coefficientsPerSection, newSections.begin() + (i + 1) * coefficientsPerSection, section);
+        else
+            section[0] = 1.0f;
+
+        if (i >= numSections)
+        {
+            float* current = coefficients.data() + i * coefficientsPerSection;
+            std::fill(current, current + coefficientsPerSection, 0.0f);
+            current[0] = 1.0f;
+        }
+    }
+
+    targetSections = newCount;
+
+    if (rampSamples > 0 && numSections > 0 && newCount > 0)
+    {
+        numSections = juce::jmax(numSections, newCount);
+        rampLength = rampSamples;
+        rampSamplesRemaining = rampSamples;
+    }
+    else
+    {
+        // 단 구성이 바뀌면 상태가 맞지 않으므로 비움
+        if (newCount != numSections)
+            reset();
+
+        coefficients = targetCoefficients;
+        numSections = newCount;
+        rampSamplesRemaining = 0;
+    }
+}
+
+void BiquadCascade::blendCoefficients(float t)
+{
+    for (size_t i = 0; i < rampCoefficients.size(); ++i)
+        rampCoefficients[i] = coefficients[i] + t * (targetCoefficients[i] - coefficients[i]);
+}
+
+void BiquadCascade::process(const juce::dsp::ProcessContextReplacing<float>& context)
+{
+    auto& block = context.getOutputBlock();
+    const int numSamples = static_cast<int>(block.getNumSamples());
+    const int channels = juce::jmin(static_cast<int>(block.getNumChannels()), numChannels);
+    const int stride = maxSections * 2;
+
+    if (numSections == 0)
+        return;
+
+    if (rampSamplesRemaining <= 0)
+    {
+        for (int ch = 0; ch < channels; ++ch)
+            processSections(coefficients.data(), states.data() + ch * stride, numSections,
+                            block.getChannelPointer(static_cast<size_t>(ch)), numSamples);
+
+        return;
+    }
+
+    // 램프: 짧은 구간마다 구간 가운데 시점의 보간 계수로 처리
+    constexpr int chunkSize = 16;
+    const int elapsed = rampLength - rampSamplesRemaining;
+
+    for (int start = 0; start < numSamples; start += chunkSize)
+    {
+        const int count = juce::jmin(chunkSize, numSamples - start);
+        blendCoefficients(juce::jmin(1.0f, (static_cast<float>(elapsed + start) + 0.5f * static_cast<float>(count))
+                                           / static_cast<float>(rampLength)));
+
+        for (int ch = 0; ch < channels; ++ch)
+            processSections(rampCoefficients.data(), states.data() + ch * stride, numSections,
+                            block.getChannelPointer(static_cast<size_t>(ch)) + start, count);
+    }
+
+    rampSamplesRemaining -= numSamples;
+
+    if (rampSamplesRemaining <= 0)
+    {
+        coefficients = targetCoefficients;
+        numSections = targetSections;
+        rampSamplesRemaining = 0;
+    }
+}
+
+void BiquadCascade::processSections(const float* sectionCoefficients, double* state, int count, float* samples, int numSamples)
+{
+    for (int s = 0; s < count; ++s)
+    {
+        const float* c = sectionCoefficients + s * coefficientsPerSection;
+        const double b0 = c[0], b1 = c[1], b2 = c[2], a1 = c[3], a2 = c[4];
+        double s1 = state[s * 2];
+        double s2 = state[s * 2 + 1];
+
+        // transposed direct form II
+        // 코너가 수십 Hz인 단은 극점이 단위원에 아주 가까워 float 상태로는 반올림 잡음이 크게 증폭됨
+        // (사인에 대해 -55 dB 수준) 상태와 연산은 double로
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const double input = samples[i];
+            const double output = b0 * input + s1;
+            s1 = b1 * input - a1 * output + s2;
+            s2 = b2 * input - a2 * output;
+            samples[i] = static_cast<float>(output);
+        }
+
+        state[s * 2] = s1;
+        state[s * 2 + 1] = s2;
+    }
+}
+
+size_t BiquadCascade::getStateMemoryUsage() const
+{
+    return (coefficients.capacity() + targetCoefficients.capacity() + rampCoefficients.capacity()) * sizeof(float)
+         + states.capacity() * sizeof(double);
+}
@@ -0,0 +1,73 @@
+/*
+  ==============================================================================
+
+    BiquadCascade.h
+    2차 IIR 직렬 연결 (저역 shelf 맞춤 설계, 계수 램프 지원)
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_dsp/juce_dsp.h>
+#include <vector>
+
+// 단마다 계수 5개 (b0, b1, b2, a1, a2, a0 = 1로 정규화), transposed direct form II로 처리
+class BiquadCascade
+{
+public:
+    BiquadCascade();
+    ~BiquadCascade();
+
+    static constexpr int coefficientsPerSection = 5;
+    static constexpr int numLowShelves = 4;  // fitLowShelves가 만드는 단 수
+    static constexpr int numLowShelfCoefficients = numLowShelves * coefficientsPerSection;
+    static constexpr int maxFitPoints = 64;  // fitLowShelves가 쓰는 점 수 (넘는 점은 버림)
+
+    // 고정된 코너 주파수의 low-shelf 단들을 주파수별 gain(dB, 오름차순 주파수)의 crossover 아래 부분에 맞춤
+    // crossover 위는 0 dB를 목표로 하므로 나머지 곡선은 짧은 FIR이 맡을 수 있음
+    // 결과 numLowShelfCoefficients개를 sections에 씀 (작업 버퍼는 스택, 오디오 스레드 설계에서도 할당 없음)
+    static void fitLowShelves(const float* frequencies, const float* gainsDB, int numPoints,
+                              double sampleRate, double crossoverHz, float* sections);
+
+    // 계수 묶음의 실제 주파수 응답 크기 (dB)
+    static float getMagnitudeDB(const std::vector<float>& sections, double frequency, double sampleRate);
+    static float getMagnitudeDB(const float* sections, int numSections, double frequency, double sampleRate);
+
+    // 모든 버퍼는 여기서 미리 할당
+    void prepare(int maxSections, int numChannels);
+    void reset();
+
+    // 계수는 복사해서 보관 (단 수는 prepare의 maxSections 이하)
+    // rampSamples 동안 계수를 짧은 구간마다 선형 보간, 0이면 즉시 교체
+    // 분모 계수의 안정 영역(삼각형)이 볼록이므로 안정한 두 단 사이의 보간도 안정하고,
+    // 상태는 그대로 이어지므로 출력이 끊기지 않음
+    void setSections(const std::vector<float>& newSections, int rampSamples);
+
+    void process(const juce::dsp::ProcessContextReplacing<float>& context);
+
+    bool isRamping() const { return rampSamplesRemaining > 0; }
+    int getNumSections() const { return numSections; }
+
+    size_t getStateMemoryUsage() const;
+
+private:
+    static void processSections(const float* sectionCoefficients, double* state, int count, float* samples, int numSamples);
+    void blendCoefficients(float t);
+
+    int maxSections = 0;
+    int numSections = 0;  // 램프 중에는 이전/새 단 수 중 큰 쪽 (남는 단은 통과 단)
+
+    // 채널마다 단마다 상태 2개 (s1, s2, double)
+    std::vector<float> coefficients;
+    std::vector<float> targetCoefficients;
+    std::vector<float> rampCoefficients;
+    std::vector<double> states;
+    int targetSections = 0;
+    int rampLength = 0;
+    int rampSamplesRemaining = 0;
+    int numChannels = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BiquadCascade)
+};
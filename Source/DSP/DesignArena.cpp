@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+    DesignArena.cpp
+    필터 설계용 scratch arena 구현
+
+  ==============================================================================
+*/
+
+#include "DesignArena.h"
+
+namespace
+{
+    constexpr size_t arenaAlignment = 16;
+
+    size_t alignUp(size_t value)
+    {
+        return (value + arenaAlignment - 1) & ~(arenaAlignment - 1);
+    }
+}
+
+DesignArena::DesignArena()
+{
+}
+
+DesignArena::~DesignArena()
+{
+}
+
+void DesignArena::reserve(size_t bytes, int fftOrder)
+{
+    // 정렬 여유분 포함 (std::vector의 시작 주소는 16바이트 정렬이 아닐 수도 있음)
+    const size_t required = alignUp(bytes) + arenaAlignment;
+
+    if (storage.size() < required)
+    {
+        storage.assign(required, 0);
+        capacityBytes.store(storage.size());
+    }
+
+    // IRFFT는 작은 차수부터 필요한 차수까지 (적응형 길이 후보가 짧은 차수부터 씀)
+    for (int order = 1; order <= juce::jmin(fftOrder, maxFFTOrder); ++order)
+    {
+        auto& fft = ffts[static_cast<size_t>(order)];
+        if (fft == nullptr)
+            fft = std::make_unique<juce::dsp::FFT>(order);
+    }
+}
+
+void DesignArena::reset()
+{
+    used = 0;
+    peak = 0;
+}
+
+char* DesignArena::allocateBytes(size_t numBytes)
+{
+    auto base = reinterpret_cast<std::uintptr_t>(storage.data());
+    const size_t offset = alignUp(base + used) - base;
+
+    if (offset + numBytes > storage.size())
+    {
+        jassertfalse;  // reserve가 설계 크기보다 작음
+        return nullptr;
+    }
+
+    used = offset + numBytes;
+    peak = juce::jmax(peak, used);
+    return storage.data() + offset;
+}
+
+const juce::dsp::FFT& DesignArena::getFFT(int order)
+{
+    auto& fft = ffts[static_cast<size_t>(juce::jlimit(0, maxFFTOrder, order))];
+
+    // reserve하지 않은 차수는 여기서 만듦 (할당이 생기므로 jassert)
+    if (fft == nullptr)
+    {
+        jassertfalse;
+        fft = std::make_unique<juce::dsp::FFT>(order);
+    }
+
+    return *fft;
+}
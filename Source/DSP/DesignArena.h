@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+    DesignArena.h
+    필터 설계용 scratch arena (미리 할당한 버퍼에서 앞으로만 나눠 씀)
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_dsp/juce_dsp.h>
+#include <vector>
+#include <array>
+#include <memory>
+#include <atomic>
+
+// arena 안의 float 구간 (다음 reset/rewind 전까지 유효)
+struct DesignSpan
+{
+    float* data = nullptr;
+    int size = 0;
+
+    bool empty() const { return size <= 0; }
+    float* begin() const { return data; }
+    float* end() const { return data + size; }
+    float& operator[](int index) const { return data[index]; }
+};
+
+// 설계 한 번이 쓰는 작업 버퍼 전체 (스펙트럼, 계수, 부분합)와 IRFFT 객체
+// reserve()만 할당하고, 설계 중에는 allocate/rewind로 위치만 옮기므로 힙 할당이 없음
+// 한 번에 한 스레드만 사용 (인스턴스마다 오디오 스레드용/작업 스레드용을 따로 둠)
+class DesignArena
+{
+public:
+    DesignArena();
+    ~DesignArena();
+
+    static constexpr int maxFFTOrder = 20;
+
+    // 필요한 크기와 IRFFT 차수까지 미리 할당 (이미 충분하면 아무것도 하지 않음)
+    void reserve(size_t bytes, int fftOrder);
+
+    // 설계 시작 시 처음부터 다시 씀 (peak는 설계마다 새로 잼)
+    void reset();
+
+    size_t getMark() const { return used; }
+    void rewind(size_t mark) { used = mark; }
+
+    // 16바이트 정렬, 0으로 채우지 않음 (모자라면 jassert 후 nullptr)
+    template <typename Type>
+    Type* allocate(int count)
+    {
+        auto* bytes = allocateBytes(sizeof(Type) * static_cast<size_t>(juce::jmax(0, count)));
+        return reinterpret_cast<Type*>(bytes);
+    }
+
+    DesignSpan allocateSpan(int size)
+    {
+        return { allocate<float>(size), size };
+    }
+
+    // reserve한 차수의 FFT (작업 버퍼가 객체 안에 있으므로 arena를 쓰는 스레드만 사용)
+    const juce::dsp::FFT& getFFT(int order);
+    bool hasFFT(int order) const { return order >= 0 && order <= maxFFTOrder && ffts[static_cast<size_t>(order)] != nullptr; }
+
+    size_t getCapacityBytes() const { return capacityBytes.load(); }
+    size_t getPeakBytes() const { return peak; }
+
+private:
+    char* allocateBytes(size_t numBytes);
+
+    std::vector<char> storage;
+    size_t used = 0;
+    size_t peak = 0;
+    std::atomic<size_t> capacityBytes { 0 };  // 메모리 보고용 (다른 스레드에서 읽음)
+    std::array<std::unique_ptr<juce::dsp::FFT>, maxFFTOrder + 1> ffts;
+
+    JUCE_DECLARE_NON_COPYABLE(DesignArena)
+};
@@ -11,200 +11,2104 @@
 #include "ISO226Data.h"
 #include <cmath>
 #include <complex>
+#include <limits>
+#include <array>
 
+namespace
+{
+    // ISO 226:2003 데이터 (AudioUnit 코드에서 가져옴)
+    // 인스턴스마다 복사하지 않고 모든 인스턴스가 읽기 전용으로 공유
+    constexpr int numISOCurves = 9;
+    
+    const float isoCurveData[numISOCurves][ISO226::NUM_FREQUENCIES] = {
+        // 10 phon curve
+        {
+            31.0f, 27.4f, 24.2f, 21.4f, 19.2f, 17.1f, 15.3f, 13.7f, 12.2f, 10.8f,
+            9.6f, 8.5f, 7.5f, 6.5f, 5.6f, 4.9f, 4.2f, 3.7f, 3.4f, 3.3f,
+            3.7f, 4.9f, 7.1f, 9.7f, 12.0f, 13.8f, 14.8f, 14.4f, 13.2f, 11.1f, 8.1f
+        },
+        
+        // 20 phon curve
+        {
+            42.4f, 38.2f, 34.7f, 31.5f, 28.9f, 26.3f, 23.9f, 21.7f, 19.8f, 17.8f,
+            16.0f, 14.4f, 12.9f, 11.4f, 10.2f, 9.2f, 8.3f, 7.6f, 7.0f, 6.8f,
+            7.0f, 8.0f, 10.2f, 13.2f, 16.3f, 19.2f, 21.7f, 23.1f, 23.6f, 22.9f, 20.7f
+        },
+        
+        // 30 phon curve
+        {
+            52.1f, 47.9f, 44.3f, 40.8f, 37.9f, 35.0f, 32.3f, 29.8f, 27.4f, 25.0f,
+            22.8f, 20.8f, 19.0f, 17.1f, 15.5f, 14.1f, 12.9f, 12.0f, 11.4f, 11.1f,
+            11.3f, 12.3f, 14.6f, 17.8f, 21.3f, 25.0f, 28.5f, 31.2f, 33.0f, 33.8f, 32.5f
+        },
+        
+        // 40 phon curve
+        {
+            61.8f, 57.6f, 53.7f, 49.9f, 46.7f, 43.5f, 40.5f, 37.6f, 34.9f, 32.1f,
+            29.6f, 27.2f, 25.0f, 22.8f, 20.8f, 19.0f, 17.5f, 16.3f, 15.6f, 15.2f,
+            15.4f, 16.5f, 18.9f, 22.3f, 26.2f, 30.5f, 34.8f, 38.5f, 41.3f, 43.0f, 42.7f
+        },
+        
+        // 50 phon curve
+        {
+            71.5f, 67.3f, 63.3f, 59.3f, 55.9f, 52.5f, 49.2f, 46.0f, 42.9f, 39.8f,
+            36.8f, 34.0f, 31.4f, 28.7f, 26.3f, 24.1f, 22.3f, 20.8f, 19.9f, 19.4f,
+            19.6f, 20.8f, 23.5f, 27.3f, 31.8f, 36.9f, 42.3f, 47.2f, 51.2f, 53.8f, 54.4f
+        },
+        
+        // 60 phon curve
+        {
+            81.2f, 77.0f, 73.0f, 68.9f, 65.4f, 61.8f, 58.2f, 54.7f, 51.2f, 47.6f,
+            44.2f, 40.9f, 37.8f, 34.6f, 31.8f, 29.2f, 27.0f, 25.3f, 24.1f, 23.5f,
+            23.6f, 24.9f, 27.7f, 31.9f, 37.0f, 43.0f, 49.6f, 55.9f, 61.3f, 65.2f, 66.8f
+        },
+        
+        // 70 phon curve
+        {
+            90.9f, 86.8f, 82.7f, 78.5f, 74.9f, 71.2f, 67.5f, 63.8f, 60.0f, 56.1f,
+            52.3f, 48.7f, 45.1f, 41.5f, 38.2f, 35.2f, 32.6f, 30.5f, 29.0f, 28.2f,
+            28.2f, 29.5f, 32.5f, 37.1f, 42.9f, 49.9f, 57.8f, 65.7f, 72.7f, 78.1f, 80.8f
+        },
+        
+        // 80 phon curve
+        {
+            100.7f, 96.5f, 92.5f, 88.2f, 84.5f, 80.7f, 76.8f, 72.9f, 68.9f, 64.7f,
+            60.5f, 56.5f, 52.5f, 48.5f, 44.8f, 41.3f, 38.3f, 35.8f, 34.0f, 33.0f,
+            32.8f, 34.2f, 37.3f, 42.3f, 48.7f, 56.8f, 66.1f, 75.8f, 84.6f, 91.4f, 95.1f
+        },
+        
+        // 90 phon curve
+        {
+            110.4f, 106.3f, 102.3f, 97.9f, 94.1f, 90.2f, 86.3f, 82.2f, 78.0f, 73.5f,
+            68.9f, 64.5f, 60.1f, 55.6f, 51.4f, 47.5f, 44.1f, 41.2f, 39.0f, 37.8f,
+            37.5f, 38.8f, 42.1f, 47.5f, 54.6f, 63.8f, 74.8f, 86.5f, 97.3f, 105.5f, 110.0f
+        }
+    };
+    
+    // 10 phon 간격 곡선 (10-90 phon), 없으면 nullptr
+    const float* findISOCurve(float phon)
+    {
+        const int index = static_cast<int>(phon / 10.0f) - 1;
+        
+        if (phon != static_cast<float>((index + 1) * 10) || index < 0 || index >= numISOCurves)
+            return nullptr;
+        
+        return isoCurveData[index];
+    }
+}
+
+namespace
+{
+    // Loudness 파라미터 간격 (0.1 phon)
+    constexpr float loudnessResolution = 0.1f;
+    
+    float quantiseLoudness(float value)
+    {
+        return std::round(value / loudnessResolution) * loudnessResolution;
+    }
+    
+    // 파티션 크기를 뺀 키 (계수만 있는 저장소 항목)
+    FilterDesignKey getCoefficientKey(FilterDesignKey key)
+    {
+        key.partitionSize = 0;
+        return key;
+    }
+    
+    // 적응형 길이 설계 후보 (31, 63, 127, ... 탭), 무시할 IR 에너지 비율 (-60 dB)
+    constexpr int minAdaptiveFilterTaps = 31;
+    constexpr double trimEnergyRatio = 1.0e-6;
+    
+    // 양 끝에서 에너지가 무시할 만한 샘플 쌍을 잘라냄 (대칭을 유지하므로 중심/레이턴시는 그대로)
+    // span의 범위만 좁히고 잘라낸 한쪽 샘플 수를 반환
+    int trimNegligibleTails(DesignSpan& coefficients)
+    {
+        double totalEnergy = 0.0;
+        for (float c : coefficients)
+            totalEnergy += static_cast<double>(c) * c;
+        
+        const int size = coefficients.size;
+        double removedEnergy = 0.0;
+        int trimmed = 0;
+        
+        while (trimmed < (size - 1) / 2)
+        {
+            const double pairEnergy = static_cast<double>(coefficients[trimmed]) * coefficients[trimmed]
+                                    + static_cast<double>(coefficients[size - 1 - trimmed]) * coefficients[size - 1 - trimmed];
+            
+            if (removedEnergy + pairEnergy > totalEnergy * trimEnergyRatio)
+                break;
+            
+            removedEnergy += pairEnergy;
+            ++trimmed;
+        }
+        
+        coefficients.data += trimmed;
+        coefficients.size -= 2 * trimmed;
+        return trimmed;
+    }
+    
+    // hybrid 엔진: 이 주파수 아래의 곡선을 저역 shelf 단에 맞춤
+    constexpr double hybridCrossoverHz = 1000.0;
+    
+    // 설계 한 번의 arena 크기: firwin2 작업 버퍼(n점 복소, 앞쪽이 결과 계수), 탭 구간 부분합,
+    // 적응형 설계에서 앞에 0을 붙인 결과 (마지막 후보의 작업 버퍼 뒤에 만듦)
+    size_t getDesignArenaBytes(int maxTaps, int chunkSize)
+    {
+        const int n = 2 * juce::nextPowerOfTwo(juce::jmax(1, maxTaps));
+        return static_cast<size_t>(n) * sizeof(std::complex<float>)
+             + static_cast<size_t>(maxTaps / chunkSize + 2) * sizeof(std::complex<double>)
+             + static_cast<size_t>(maxTaps) * sizeof(float)
+             + 64;  // 할당마다 16바이트 정렬
+    }
+    
+    // 같은 설정의 짧은 미리듣기 키: 앞에 0을 더 붙여 전체 길이 IR과 레이턴시를 맞춤
+    FilterDesignKey getPreviewKey(FilterDesignKey key, int numTaps)
+    {
+        key.latencyPadding += key.filterTaps / 2 - numTaps / 2;
+        key.filterTaps = numTaps;
+        return key;
+    }
+}
+
+//==============================================================================
 LoudnessCompensatorDSP::LoudnessCompensatorDSP()
+    : designJobs(std::make_unique<SharedWorkerPool::Client>(*workerPool))
+{
+    // 기본 파라미터로 target/reference phon을 맞춰 둠
+    updateDesignParameters();
+}
+
+LoudnessCompensatorDSP::~LoudnessCompensatorDSP()
+{
+    // 오디오 스레드가 예약한 설계를 먼저 넘겨야 그 키를 기다리는 작업이 끝남
+    completeClaimedDesign();
+    
+    // 대기 중인 작업을 지우고 실행 중인 작업/폴링이 끝날 때까지 기다림 (이후 작업 스레드는 이 인스턴스를 건드리지 않음)
+    // 핸들을 비우기 전에 끊음: unique_ptr은 포인터를 먼저 비우고 소멸자를 부르므로, 그 소멸자가 기다리는
+    // 폴링 콜백이 designJobs->addJob에서 nullptr을 읽게 됨
+    designJobs->shutdown();
+    designJobs = nullptr;
+    cancelInitialDesign();
+    
+    convolver.setImpulseSpectra(nullptr, 0);
+    currentIR = nullptr;
+    restoredDesign = nullptr;
+    irStore->releaseUnused();
+}
+
+void LoudnessCompensatorDSP::setEasyLoudness(float value)
+{
+    const float previousLoudness = easyLoudness;
+    
+    // 파라미터 간격으로 맞춰 두면 자동화 중간값, 추측 설계, 세션 복원이 같은 설계 키를 씀
+    easyLoudness = juce::jlimit(20.0f, 70.0f, quantiseLoudness(value));
+    updateDesignParameters();
+    
+    if (easyLoudness != previousLoudness)
+        trackLoudnessMotion(easyLoudness - previousLoudness);
+}
+
+bool LoudnessCompensatorDSP::isDesignReady(float value) const
+{
+    // spectral 엔진은 설계 없이 bin gain만 다시 계산
+    if (params.engine == FilterEngine::spectral)
+        return true;
+    
+    const float loudness = juce::jlimit(20.0f, 70.0f, quantiseLoudness(value));
+    
+    auto key = makeDesignKey();
+    key.targetPhon = loudness;
+    key.referencePhon = calculateReferencePhon(loudness, params);
+    return irStore->tryFind(key) != nullptr;
+}
+
+void LoudnessCompensatorDSP::updateDesignParameters()
+{
+    const float previousTargetPhon = targetPhon;
+    const float previousReferencePhon = referencePhon;
+    
+    // Easy Loudness (20-70) → Target Phon (20-70)
+    targetPhon = easyLoudness;
+    referencePhon = calculateReferencePhon(targetPhon, params);
+    
+    // 에디터 표시용
+    publishedTargetPhon.store(targetPhon);
+    publishedReferencePhon.store(referencePhon);
+    
+    // 설계 결과가 바뀔 때만 요청
+    if (targetPhon != previousTargetPhon || referencePhon != previousReferencePhon)
+        requestDesign();
+}
+
+void LoudnessCompensatorDSP::trackLoudnessMotion(float delta)
+{
+    // spectral 엔진은 미리 설계할 것이 없음
+    if (!backgroundWorkStarted.load() || params.engine == FilterEngine::spectral)
+        return;
+    
+    // 같은 방향으로 계속 움직이면 변화량을 평균, 방향이 바뀌면 새로 시작
+    if (delta * loudnessStep > 0.0f)
+        loudnessStep = 0.5f * (loudnessStep + delta);
+    else
+        loudnessStep = delta;
+    
+    auto& request = speculationRequests.getWriteBuffer();
+    request.parameters = params;
+    request.easyLoudness = easyLoudness;
+    request.step = loudnessStep;
+    request.key = makeDesignKey();
+    speculationRequests.publish();
+}
+
+float LoudnessCompensatorDSP::calculateReferencePhon(float target, const Parameters& parameters) const
+{
+    // Expert Mode가 아닐 때만 적응형 파라미터 적용
+    float k = parameters.kValue;
+    float delta = parameters.deltaMax;
+    
+    if (!parameters.expertMode)
+    {
+        calculateAdaptiveParameters(target, k, delta);
+    }
+    
+    // Reference Phon 계산 (exponential decay)
+    const float deltaMin = 1.0f;
+    float gap = deltaMin + (delta - deltaMin) * std::exp(-(target - 20.0f) / k);
+    
+    // Expert Mode가 아닐 때 페이드아웃 및 헤드룸 보호 적용
+    if (!parameters.expertMode)
+    {
+        // 페이드아웃 (80-85 phon)
+        float fadeScale = 1.0f;
+        if (target >= 80.0f && target < 85.0f)
+        {
+            fadeScale = 1.0f - (target - 80.0f) / 5.0f;
+        }
+        else if (target >= 85.0f)
+        {
+            fadeScale = 0.0f;
+        }
+        
+        // 헤드룸 보호 (70 phon 이상)
+        float headroomScale = 1.0f;
+        if (target > 70.0f)
+        {
+            headroomScale = 1.0f - 0.3f * (target - 70.0f) / 20.0f;
+            headroomScale = juce::jmax(0.7f, headroomScale);
+        }
+        
+        gap *= fadeScale * headroomScale;
+    }
+    
+    return juce::jmax(target + gap, target + 0.1f);
+}
+
+void LoudnessCompensatorDSP::requestDesign()
+{
+    designRequests.fetch_add(1);
+    requestedGeneration.fetch_add(1);
+}
+
+void LoudnessCompensatorDSP::beginParameterBatch()
+{
+    batchDepth.fetch_add(1);
+}
+
+void LoudnessCompensatorDSP::endParameterBatch()
+{
+    jassert(batchDepth.load() > 0);
+    batchDepth.fetch_sub(1);
+}
+
+bool LoudnessCompensatorDSP::runPendingDesign()
+{
+    // 배치 중이면 끝날 때까지 현재 필터 유지
+    if (batchDepth.load() > 0)
+        return false;
+    
+    // 설계 시작 시점의 세대를 기록: 설계 중 들어온 변경은 다음 블록에서 한 번 더
+    const auto generation = requestedGeneration.load();
+    if (generation == executedGeneration)
+        return false;
+    
+    // 같은 키를 다른 스레드가 설계 중이면 기다리지 않고 다음 블록에 다시 (오프라인 렌더링은 기다림)
+    if (!updateFIRCoefficients(offlineRequested || !backgroundWorkStarted.load()))
+        return false;
+    
+    executedGeneration = generation;
+    return true;
+}
+
+void LoudnessCompensatorDSP::setParameters(const Parameters& newParameters)
+{
+    const juce::ScopedLock sl(parameterWriteLock);
+    pendingParameters = newParameters;
+    publishParameters();
+}
+
+LoudnessCompensatorDSP::Parameters LoudnessCompensatorDSP::getParameters() const
+{
+    const juce::ScopedLock sl(parameterWriteLock);
+    return pendingParameters;
+}
+
+void LoudnessCompensatorDSP::setParametersFromAudioThread(const Parameters& newParameters)
+{
+    // 읽는 쪽이 직접 쓰므로 잠금/트리플 버퍼 없이 다음 acquireParameters가 바로 가져감
+    audioThreadParameters = limitParameters(newParameters);
+    audioThreadParametersPending = true;
+    publishReadouts(audioThreadParameters);
+}
+
+void LoudnessCompensatorDSP::publishDisplayValues(float easyLoudnessValue, const Parameters& parameters)
+{
+    // setEasyLoudness/updateDesignParameters와 같은 계산 (오디오 스레드가 적용하면 같은 값으로 다시 씀)
+    const auto limited = limitParameters(parameters);
+    const float target = juce::jlimit(20.0f, 70.0f, quantiseLoudness(easyLoudnessValue));
+    
+    publishedTargetPhon.store(target);
+    publishedReferencePhon.store(calculateReferencePhon(target, limited));
+    publishReadouts(limited);
+}
+
+void LoudnessCompensatorDSP::publishParameters()
+{
+    // 범위 제한 후 통째로 발행 (오디오 스레드는 항상 완결된 묶음만 봄)
+    auto& snapshot = parameterSnapshots.getWriteBuffer();
+    snapshot = limitParameters(pendingParameters);
+    publishReadouts(snapshot);
+    parameterSnapshots.publish();
+}
+
+LoudnessCompensatorDSP::Parameters LoudnessCompensatorDSP::limitParameters(Parameters snapshot)
+{
+    snapshot.kValue = juce::jlimit(5.0f, 30.0f, snapshot.kValue);
+    snapshot.deltaMax = juce::jlimit(10.0f, 40.0f, snapshot.deltaMax);
+    snapshot.filterTaps = juce::jlimit(1, maxExtremeFilterTaps, snapshot.filterTaps);
+    snapshot.responseTolerance = juce::jlimit(0.0f, 6.0f, snapshot.responseTolerance);
+    snapshot.spectralFrameSize = juce::jlimit(SpectralGainFilter::minFrameSize, SpectralGainFilter::maxFrameSize,
+                                              juce::nextPowerOfTwo(juce::jmax(1, snapshot.spectralFrameSize)));
+    snapshot.spectralHopSize = juce::jlimit(snapshot.spectralFrameSize / SpectralGainFilter::maxOverlap, snapshot.spectralFrameSize / 2,
+                                            juce::nextPowerOfTwo(juce::jmax(1, snapshot.spectralHopSize)));
+    return snapshot;
+}
+
+void LoudnessCompensatorDSP::publishReadouts(const Parameters& snapshot)
+{
+    publishedLatency.store(snapshot.getLatencySamples());
+    publishedEngineFilterTaps.store(snapshot.getEngineFilterTaps());
+    publishedConstantLatency.store(snapshot.constantLatency);
+}
+
+void LoudnessCompensatorDSP::acquireParameters(int availableFilterTaps)
+{
+    // 미뤄 둔 묶음이 있으면 새 묶음이 없어도 다시 봄 (읽기 버퍼는 다음 acquire 전까지 그대로)
+    // 오디오 스레드가 직접 쓴 묶음이 있으면 그것을 (한 인스턴스는 한 쓰기 경로만 씀)
+    if (!parameterSnapshots.acquire() && !audioThreadParametersPending && !parametersHeld)
+        return;
+    
+    const auto& latest = audioThreadParametersPending ? audioThreadParameters : parameterSnapshots.getReadBuffer();
+    
+    // 할당된 버퍼보다 긴 필터(Extreme 단계)는 메시지 스레드가 growFilterCapacity로 늘릴 때까지 이전 묶음으로 처리
+    parametersHeld = latest.getEngineFilterTaps() > availableFilterTaps;
+    if (parametersHeld)
+        return;
+    
+    // IR 길이/레이턴시가 바뀌면 설계 요청 (phon 변화는 updateDesignParameters에서 판단)
+    if (latest.filterTaps != params.filterTaps || latest.constantLatency != params.constantLatency
+        || latest.responseTolerance != params.responseTolerance || latest.engine != params.engine
+        || latest.spectralFrameSize != params.spectralFrameSize || latest.spectralHopSize != params.spectralHopSize)
+        requestDesign();
+    
+    params = latest;
+    audioThreadParametersPending = false;
+    updateDesignParameters();
+}
+
+void LoudnessCompensatorDSP::setBypass(bool shouldBypass)
+{
+    const juce::ScopedLock sl(parameterWriteLock);
+    pendingParameters.bypass = shouldBypass;
+    publishParameters();
+}
+
+void LoudnessCompensatorDSP::setKValue(float k)
+{
+    const juce::ScopedLock sl(parameterWriteLock);
+    pendingParameters.kValue = k;
+    publishParameters();
+}
+
+void LoudnessCompensatorDSP::setDeltaMax(float delta)
+{
+    const juce::ScopedLock sl(parameterWriteLock);
+    pendingParameters.deltaMax = delta;
+    publishParameters();
+}
+
+void LoudnessCompensatorDSP::setFilterTaps(int taps)
+{
+    const juce::ScopedLock sl(parameterWriteLock);
+    pendingParameters.filterTaps = taps;
+    publishParameters();
+}
+
+void LoudnessCompensatorDSP::setConstantLatency(bool shouldBeConstant)
+{
+    const juce::ScopedLock sl(parameterWriteLock);
+    pendingParameters.constantLatency = shouldBeConstant;
+    publishParameters();
+}
+
+void LoudnessCompensatorDSP::setQualityGovernor(bool enabled)
+{
+    const juce::ScopedLock sl(parameterWriteLock);
+    pendingParameters.qualityGovernor = enabled;
+    publishParameters();
+}
+
+void LoudnessCompensatorDSP::setResponseTolerance(float decibels)
+{
+    const juce::ScopedLock sl(parameterWriteLock);
+    pendingParameters.responseTolerance = decibels;
+    publishParameters();
+}
+
+void LoudnessCompensatorDSP::setFilterEngine(FilterEngine newEngine)
+{
+    const juce::ScopedLock sl(parameterWriteLock);
+    pendingParameters.engine = newEngine;
+    publishParameters();
+}
+
+void LoudnessCompensatorDSP::setSpectralFrameSize(int frameSize, int hopSize)
+{
+    const juce::ScopedLock sl(parameterWriteLock);
+    pendingParameters.spectralFrameSize = frameSize;
+    pendingParameters.spectralHopSize = hopSize;
+    publishParameters();
+}
+
+void LoudnessCompensatorDSP::setExpertMode(bool expert)
+{
+    const juce::ScopedLock sl(parameterWriteLock);
+    pendingParameters.expertMode = expert;
+    publishParameters();
+}
+
+void LoudnessCompensatorDSP::setFilterRampBlocks(int blocks)
+{
+    filterRampBlocks = juce::jmax(0, blocks);
+}
+
+void LoudnessCompensatorDSP::setProgressiveDesign(bool shouldBeProgressive)
+{
+    progressiveDesign.store(shouldBeProgressive);
+}
+
+void LoudnessCompensatorDSP::setNonRealtime(bool isNonRealtime)
+{
+    offlineRequested = isNonRealtime;
+}
+
+void LoudnessCompensatorDSP::prepare(double sampleRate, int maximumBlockSize)
+{
+    // 이전 prepare에서 시작한 백그라운드 설계가 남아 있으면 끝날 때까지 기다린 뒤 결과는 버림
+    // 오디오 스레드가 예약한 설계를 먼저 넘겨야 그 키를 기다리는 작업이 끝남 (소멸자와 같은 순서)
+    completeClaimedDesign();
+    cancelInitialDesign();
+    
+    const auto prepareStart = juce::Time::getMillisecondCounterHiRes();
+    currentSampleRate = sampleRate;
+    acquireParameters(maxExtremeFilterTaps);
+    
+    // Convolution 준비 (표준 최대 탭, Extreme 단계를 골랐으면 그 탭 수 기준으로 미리 할당)
+    const int partitionSize = juce::jlimit(64, 4096, juce::nextPowerOfTwo(juce::jmax(1, maximumBlockSize)));
+    filterCapacity = juce::jlimit(maxFilterTaps, maxExtremeFilterTaps, params.getEngineFilterTaps());
+    publishedFilterCapacity.store(filterCapacity);
+    preparedBlockSize = juce::jmax(1, maximumBlockSize);
+    offlineActive = false;
+    prepareConvolution(partitionSize);
+    reserveDesignArena(audioDesignArena, maxFilterTaps, juce::jmax(partitionSize, tailBlockSize));
+    warpedFilter.prepare(warpedFilterTaps, 2, maxFilterTaps / 2);
+    warpedFilter.setWarpingFactor(WarpedFIRFilter::getWarpingFactor(sampleRate));
+    shelfFilter.prepare(BiquadCascade::numLowShelves, 2);
+    spectralFilter.prepare(sampleRate, 2, maxFilterTaps / 2);
+    spectralActive = false;
+    loadedFilterTaps = 0;
+    loadedLatency = -1;
+    currentIR = nullptr;
+    sharedIRBytes.store(0);
+    
+    // 바이패스 크로스페이드
+    dryScratch.setSize(2, preparedBlockSize);
+    wetMix.reset(sampleRate, bypassFadeSeconds);
+    convolutionSuspended = false;
+    pathState = PathState::running;
+    pendingSwitchIR = nullptr;
+    pendingSpectralSwitch = false;
+    pendingRenderSwitch = false;
+    
+    irStore->releaseUnused();
+    
+    // governor는 선택한 품질에서 다시 시작
+    governorLevel = 0;
+    processLoad = 0.0f;
+    governorHoldSamples = 0;
+    publishedGovernorLevel.store(0);
+    publishedProcessLoad.store(0.0f);
+    
+    // Master gain 스무딩은 계수 램프와 같은 길이
+    masterGain.reset(juce::jmax(1, filterRampBlocks * partitionSize));
+    
+    // 초기 FIR 계수 (대기 중인 요청도 함께 처리됨)
+    // 저장소에 이미 있거나(다른 인스턴스가 설계) 오프라인 렌더링이면 바로 적용하고,
+    // 아니면 백그라운드에서 설계하는 동안 레이턴시만큼 지연된 원신호를 통과시킴
+    // (spectral 엔진은 설계가 없으므로 항상 바로 적용)
+    executedGeneration = requestedGeneration.load();
+    initialDesignStart = prepareStart;
+    initialDesignMilliseconds.store(-1.0f);
+    filterReady = false;
+    
+    const auto key = makeDesignKey();
+    
+    if (offlineRequested || params.engine == FilterEngine::spectral
+        || irStore->find(key) != nullptr || irStore->find(getCoefficientKey(key)) != nullptr)
+    {
+        updateFIRCoefficients(true);
+        filterReady = true;
+        
+        // 이력이 방금 비워졌으므로 초기 상태가 곧 채운 상태
+        pathState = PathState::running;
+        initialDesignMilliseconds.store(static_cast<float>(juce::Time::getMillisecondCounterHiRes() - prepareStart));
+    }
+    else
+    {
+        launchInitialDesign(key);
+    }
+    
+    masterGain.setCurrentAndTargetValue(juce::Decibels::decibelsToGain(getMasterGain()));
+    wetMix.setCurrentAndTargetValue(params.bypass || !filterReady ? 0.0f : 1.0f);
+    
+    // 백그라운드 작업 폴링도 처음 prepare에서 시작 (스캔 시에는 스레드를 만들지 않음)
+    loudnessStep = 0.0f;
+    preparedPartitionSize.store(partitionSize);
+    prepareClaimSpares();
+    
+    if (!backgroundWorkStarted.load())
+    {
+        designJobs->setPollCallback([this] { pollBackgroundWork(); });
+        backgroundWorkStarted.store(true);
+    }
+}
+
+void LoudnessCompensatorDSP::launchInitialDesign(const FilterDesignKey& key)
+{
+    initialDesignDone.reset();
+    
+    designJobs->addJob(SharedWorkerPool::Priority::design, [this, key]
+    {
+        auto impulseResponse = findOrDesignInBackground(key);
+        
+        // 오디오 스레드가 가져갈 때까지 참조 하나를 유지
+        if (impulseResponse != nullptr)
+        {
+            impulseResponse->incReferenceCount();
+            finishedDesign.store(impulseResponse.get());
+        }
+        
+        initialDesignDone.signal();
+    });
+}
+
+void LoudnessCompensatorDSP::cancelInitialDesign()
+{
+    // 이 인스턴스의 작업을 모두 취소 (점진/추측 설계 포함, 취소된 작업은 실행 중 표시를 풀지 못하므로 여기서 풂)
+    if (designJobs != nullptr)
+        designJobs->cancelJobs();
+    
+    refinementRunning.store(false);
+    speculationRunning.store(false);
+    
+    if (auto* finished = finishedDesign.exchange(nullptr))
+        finished->decReferenceCount();
+    
+    // 이전 설정의 전체 길이 IR도 버림 (이후에 도착하는 것은 키가 달라 적용되지 않음)
+    if (auto* refined = refinedDesign.exchange(nullptr))
+        refined->decReferenceCount();
+}
+
+bool LoudnessCompensatorDSP::collectInitialDesign()
+{
+    if (filterReady)
+        return true;
+    
+    // 오프라인 렌더링은 원신호가 섞이면 안 되므로 설계가 끝날 때까지 기다림
+    if (offlineRequested)
+        initialDesignDone.wait(-1);
+    
+    auto* finished = finishedDesign.exchange(nullptr);
+    if (finished == nullptr)
+        return false;
+    
+    // 저장소가 참조를 들고 있으므로 여기서 참조를 넘겨받아도 해제되지 않음
+    SharedImpulseResponse::Ptr impulseResponse(finished);
+    finished->decReferenceCount();
+    
+    designsExecuted.fetch_add(1);
+    applyImpulseResponse(impulseResponse);
+    masterGain.setCurrentAndTargetValue(juce::Decibels::decibelsToGain(getMasterGain()));
+    
+    filterReady = true;
+    initialDesignMilliseconds.store(static_cast<float>(juce::Time::getMillisecondCounterHiRes() - initialDesignStart));
+    return true;
+}
+
+void LoudnessCompensatorDSP::pollBackgroundWork()
+{
+    completeClaimedDesign();
+    prepareClaimSpares();
+    
+    // 점진 설계: 사용자가 기다리는 결과이므로 CPU 예산 없이 설계 우선순위로
+    if (!refinementRunning.load() && refinementRequests.acquire())
+    {
+        const auto key = refinementRequests.getReadBuffer();
+        refinementRunning.store(true);
+        
+        designJobs->addJob(SharedWorkerPool::Priority::design, [this, key]
+        {
+            refineDesign(key);
+            refinementRunning.store(false);
+        });
+    }
+    
+    // 전체 길이 설계가 진행 중이거나 대기 중이면 추측 설계는 쉼
+    if (refinementRunning.load() || refinementRequests.hasPending())
+        return;
+    
+    // 더 새로운 움직임이 발행되었으면 이전 예측은 버리고 처음부터
+    if (speculationRequests.acquire())
+    {
+        speculation = speculationRequests.getReadBuffer();
+        speculationStep = 1;
+        previousSpeculativeLoudness = speculation.easyLoudness;
+    }
+    
+    if (speculationRunning.load() || juce::Time::getMillisecondCounterHiRes() < speculationResumeTime.load())
+        return;
+    
+    while (speculationStep <= speculationDepth)
+    {
+        // 평균 변화량으로 k 단계 뒤 값을 예측 (파라미터 간격으로 맞추고 같은 값은 건너뜀)
+        const int k = speculationStep++;
+        const float loudness = juce::jlimit(20.0f, 70.0f,
+                                            quantiseLoudness(speculation.easyLoudness + speculation.step * static_cast<float>(k)));
+        if (loudness == previousSpeculativeLoudness)
+            continue;
+        
+        previousSpeculativeLoudness = loudness;
+        
+        auto key = speculation.key;
+        key.targetPhon = loudness;
+        key.referencePhon = calculateReferencePhon(loudness, speculation.parameters);
+        
+        if (irStore->find(key) != nullptr)
+            continue;
+        
+        // 한 번에 하나만, 가장 낮은 우선순위로 (다른 인스턴스의 설계/복원이 먼저)
+        speculationRunning.store(true);
+        
+        designJobs->addJob(SharedWorkerPool::Priority::speculative, [this, key]
+        {
+            const auto start = juce::Time::getMillisecondCounterHiRes();
+            rememberSpeculativeDesign(findOrDesignInBackground(key));
+            speculativeDesigns.fetch_add(1);
+            
+            // CPU 예산: 설계에 쓴 시간에 비례해 쉬어서 평균 점유율을 speculationCpuBudget 이하로
+            const auto end = juce::Time::getMillisecondCounterHiRes();
+            speculationResumeTime.store(end + (end - start) * (1.0 / speculationCpuBudget - 1.0));
+            speculationRunning.store(false);
+        });
+        return;
+    }
+}
+
+void LoudnessCompensatorDSP::refineDesign(const FilterDesignKey& key)
+{
+    auto impulseResponse = findOrDesignInBackground(key);
+    if (impulseResponse == nullptr)
+        return;
+    
+    // 오디오 스레드가 가져갈 때까지 참조 하나를 유지 (가져가지 않은 이전 결과는 여기서 놓음)
+    impulseResponse->incReferenceCount();
+    
+    if (auto* previous = refinedDesign.exchange(impulseResponse.get()))
+        previous->decReferenceCount();
+}
+
+void LoudnessCompensatorDSP::rememberSpeculativeDesign(SharedImpulseResponse::Ptr impulseResponse)
+{
+    if (impulseResponse == nullptr)
+        return;
+    
+    // 최근 추측 결과만 붙잡아 두고, 밀려난 항목은 다른 참조가 없으면 저장소에서 정리
+    speculationCache[static_cast<size_t>(nextSpeculationCacheSlot)] = std::move(impulseResponse);
+    nextSpeculationCacheSlot = (nextSpeculationCacheSlot + 1) % speculationCacheSize;
+    
+    if (nextSpeculationCacheSlot == 0)
+        irStore->releaseUnused();
+}
+
+void LoudnessCompensatorDSP::collectRefinedDesign()
+{
+    auto* refined = refinedDesign.exchange(nullptr);
+    if (refined == nullptr)
+        return;
+    
+    // 저장소가 참조를 들고 있으므로 여기서 참조를 넘겨받아도 해제되지 않음
+    SharedImpulseResponse::Ptr impulseResponse(refined);
+    refined->decReferenceCount();
+    
+    // 설계 중 설정이 바뀌었으면 버림 (새 설정은 이미 미리듣기/재설계로 처리됨)
+    // 미리듣기와 레이턴시가 같으므로 applyImpulseResponse가 계수 램프로 크로스페이드
+    if (impulseResponse->key == makeDesignKey())
+        applyImpulseResponse(impulseResponse);
+}
+
+void LoudnessCompensatorDSP::process(juce::AudioBuffer<float>& buffer)
+{
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+    const int numSamples = buffer.getNumSamples();
+    
+    // 최신 파라미터 묶음 (새로 발행된 것이 없으면 원자 읽기 한 번)
+    // 오프라인 렌더링은 기다릴 수 없으므로 Extreme 단계 버퍼를 여기서 늘림 (실시간은 메시지 스레드가 늘림)
+    acquireParameters(offlineRequested ? maxExtremeFilterTaps : filterCapacity);
+    
+    if (params.getEngineFilterTaps() > filterCapacity)
+        resizeFilterCapacity();
+    
+    // 첫 설계가 끝나기 전에는 바이패스와 같은 경로 (준비되면 크로스페이드로 들어감)
+    // 경로를 바꾸는 동안(페이드아웃, 새 경로 채우기)에도 원신호 쪽
+    const bool dry = params.bypass || !collectInitialDesign();
+    wetMix.setTargetValue(dry || pathState != PathState::running ? 0.0f : 1.0f);
+    
+    // 바이패스 완전 진입: 컨볼버를 멈추고 레이턴시만큼 지연된 원신호만 출력
+    if (dry && !wetMix.isSmoothing())
+    {
+        pushInputHistory(buffer);
+        readDelayedInput(buffer, numSamples);
+        convolutionSuspended = true;
+        return;
+    }
+    
+    // 실시간/오프라인 전환 (이전 블록까지의 입력 이력으로 새 경로를 채움)
+    if (offlineRequested != offlineActive)
+        switchRenderPath(offlineRequested);
+    
+    // 바이패스 해제 또는 전환 전 페이드아웃 완료: 미뤄 둔 전환을 적용하고 멈춰 있던 경로를 채우기 시작
+    // (오프라인 렌더링은 원신호가 섞이면 안 되므로 페이드아웃 중이어도 바로)
+    if (convolutionSuspended || (pathState == PathState::fadingOut && (offlineRequested || !wetMix.isSmoothing())))
+    {
+        applyPendingPathSwitch();
+        convolutionSuspended = false;
+    }
+    
+    // FIR 계수 업데이트 필요 시 (여러 변경이 쌓여 있어도 설계는 한 번)
+    const bool designed = runPendingDesign();
+    collectRefinedDesign();
+    
+    pushInputHistory(buffer);
+    
+    // 새 경로를 채우는 중: 이번 블록 전까지의 이력을 나눠 흘려 보내고, 따라잡기 전에는 지연된 원신호만 출력
+    // 따라잡으면 이번 블록부터 원신호에서 크로스페이드로 들어감
+    if (pathState == PathState::priming)
+    {
+        if (!advancePriming(numSamples))
+        {
+            readDelayedInput(buffer, numSamples);
+            return;
+        }
+        
+        wetMix.setTargetValue(dry ? 0.0f : 1.0f);
+    }
+    
+    // 크로스페이드 중이면 지연된 원신호를 따로 보관
+    const bool crossfading = wetMix.isSmoothing();
+    if (crossfading)
+        readDelayedInput(dryScratch, numSamples);
+    
+    // JUCE DSP 블록으로 변환
+    juce::dsp::AudioBlock<float> block(buffer);
+    
+    // Convolution 처리
+    convolve(block);
+    
+    // Master Gain 적용 (-3dB + preamp + 헤드룸/페이드아웃 보정)
+    masterGain.setTargetValue(juce::Decibels::decibelsToGain(getMasterGain()));
+    masterGain.applyGain(buffer, numSamples);
+    
+    if (crossfading)
+    {
+        const int numChannels = juce::jmin(buffer.getNumChannels(), dryScratch.getNumChannels());
+        
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float wet = wetMix.getNextValue();
+            
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                const float drySample = dryScratch.getSample(ch, i);
+                buffer.setSample(ch, i, drySample + wet * (buffer.getSample(ch, i) - drySample));
+            }
+        }
+    }
+    
+    // 설계가 끼어든 블록은 탭 수와 무관한 일회성 비용이므로 부하 평균에서 제외
+    if (!designed)
+        updateGovernor(juce::Time::getHighResolutionTicks() - startTicks, numSamples);
+}
+
+void LoudnessCompensatorDSP::updateGovernor(juce::int64 elapsedTicks, int numSamples)
+{
+    // 오프라인 렌더링은 마감 시간이 없으므로 항상 선택한 품질 (warped/hybrid 엔진은 단계가 없음)
+    if (!params.qualityGovernor || offlineActive || params.engine != FilterEngine::linearPhase || numSamples <= 0)
+    {
+        if (governorLevel > 0)
+            setGovernorLevel(0);
+        
+        return;
+    }
+    
+    const double blockSeconds = numSamples / currentSampleRate;
+    const double elapsedSeconds = static_cast<double>(elapsedTicks) / static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+    
+    // 하위 블록 길이가 달라도 같은 시간 상수가 되도록 샘플 수에 비례한 계수로 평균
+    const float alpha = static_cast<float>(juce::jmin(1.0, blockSeconds / governorAverageSeconds));
+    processLoad += alpha * (static_cast<float>(elapsedSeconds / blockSeconds) - processLoad);
+    publishedProcessLoad.store(processLoad);
+    
+    if (governorHoldSamples > 0)
+    {
+        governorHoldSamples -= numSamples;
+        return;
+    }
+    
+    if (processLoad > governorDowngradeLoad)
+        setGovernorLevel(governorLevel + 1);
+    else if (processLoad < governorUpgradeLoad && governorLevel > 0)
+        setGovernorLevel(governorLevel - 1);
+}
+
+void LoudnessCompensatorDSP::setGovernorLevel(int level)
+{
+    // 선택한 품질에서 내려갈 수 있는 단계까지만 (품질을 바꿔 단계가 남으면 여기서 정리)
+    int maxLevel = 0;
+    for (int taps = params.filterTaps; (taps + 1) / 2 - 1 >= minGovernedFilterTaps; taps = (taps + 1) / 2 - 1)
+        ++maxLevel;
+    
+    const int fromTaps = getEffectiveFilterTaps();
+    governorLevel = juce::jlimit(0, maxLevel, level);
+    publishedGovernorLevel.store(governorLevel);
+    
+    const int toTaps = getEffectiveFilterTaps();
+    if (toTaps == fromTaps)
+        return;
+    
+    // 설계 키가 바뀌므로 다음 블록에서 재설계 (같은 레이턴시라 계수 램프로 전환)
+    requestDesign();
+    governorHoldSamples = static_cast<int>(governorHoldSeconds * currentSampleRate);
+    
+    GovernorEvent event;
+    event.type = toTaps < fromTaps ? GovernorEvent::Type::downgrade : GovernorEvent::Type::upgrade;
+    event.fromTaps = fromTaps;
+    event.toTaps = toTaps;
+    event.load = processLoad;
+    event.timeMilliseconds = juce::Time::getMillisecondCounterHiRes();
+    
+    // FIFO가 가득 차 있으면(아무도 읽지 않으면) 이벤트만 버림
+    int start1, size1, start2, size2;
+    governorEventFifo.prepareToWrite(1, start1, size1, start2, size2);
+    
+    if (size1 > 0)
+    {
+        governorEvents[static_cast<size_t>(start1)] = event;
+        governorEventFifo.finishedWrite(1);
+    }
+}
+
+bool LoudnessCompensatorDSP::readGovernorEvent(GovernorEvent& event)
+{
+    int start1, size1, start2, size2;
+    governorEventFifo.prepareToRead(1, start1, size1, start2, size2);
+    
+    if (size1 == 0)
+        return false;
+    
+    event = governorEvents[static_cast<size_t>(start1)];
+    governorEventFifo.finishedRead(1);
+    return true;
+}
+
+int LoudnessCompensatorDSP::getEffectiveFilterTaps() const
+{
+    int taps = params.filterTaps;
+    
+    // 4095 → 2047 → 1023 → 511 (선택한 품질보다 높이지는 않음)
+    for (int i = 0; i < governorLevel && (taps + 1) / 2 - 1 >= minGovernedFilterTaps; ++i)
+        taps = (taps + 1) / 2 - 1;
+    
+    return taps;
+}
+
+void LoudnessCompensatorDSP::readDelayedInput(juce::AudioBuffer<float>& destination, int numSamples)
+{
+    const int historySize = inputHistory.getNumSamples();
+    const int numChannels = juce::jmin(destination.getNumChannels(), inputHistory.getNumChannels());
+    
+    const int latency = params.getLatencySamples();
+    jassert(numSamples + latency <= historySize);
+    numSamples = juce::jmin(numSamples, destination.getNumSamples(), historySize);
+    
+    // 방금 넣은 블록의 시작보다 레이턴시만큼 앞선 위치부터 읽음
+    int start = (historyPosition - numSamples - latency) % historySize;
+    if (start < 0)
+        start += historySize;
+    
+    const int first = juce::jmin(numSamples, historySize - start);
+    
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        destination.copyFrom(ch, 0, inputHistory, ch, start, first);
+        
+        if (numSamples > first)
+            destination.copyFrom(ch, first, inputHistory, ch, 0, numSamples - first);
+    }
+}
+
+void LoudnessCompensatorDSP::reset()
+{
+    resetConvolution();
+    silentSamples = 0;
+    idle = false;
+}
+
+void LoudnessCompensatorDSP::resetConvolution()
+{
+    convolver.reset();
+    warpedFilter.reset();
+    shelfFilter.reset();
+    spectralFilter.reset();
+    tailConvolver.reset();
+    tailInput.clear();
+    tailOutput.clear();
+    tailPosition = 0;
+    
+    inputHistory.clear();
+    historyPosition = 0;
+}
+
+LoudnessCompensatorDSP::MemoryUsage LoudnessCompensatorDSP::getMemoryUsage() const
+{
+    MemoryUsage usage;
+    usage.instance = sizeof(*this);
+    usage.convolutionState = convolver.getStateMemoryUsage() + tailConvolver.getStateMemoryUsage()
+                           + static_cast<size_t>(tailInput.getNumChannels() * tailInput.getNumSamples()
+                                               + tailOutput.getNumChannels() * tailOutput.getNumSamples()
+                                               + inputHistory.getNumChannels() * inputHistory.getNumSamples()
+                                               + primeScratch.getNumChannels() * primeScratch.getNumSamples()
+                                               + dryScratch.getNumChannels() * dryScratch.getNumSamples()) * sizeof(float)
+                           + warpedFilter.getStateMemoryUsage() + shelfFilter.getStateMemoryUsage()
+                           + spectralFilter.getStateMemoryUsage();
+    usage.coefficientRamp = convolver.getRampMemoryUsage() + tailConvolver.getRampMemoryUsage();
+    usage.sharedImpulseResponse = sharedIRBytes.load();
+    usage.designScratchPeak = lastDesignScratchBytes.load();
+    usage.designArena = audioDesignArena.getCapacityBytes() + backgroundDesignArena.getCapacityBytes();
+    usage.designSpares = designSpareBytes.load();
+    return usage;
+}
+
+bool LoudnessCompensatorDSP::skipIfIdle(const juce::AudioBuffer<float>& buffer)
+{
+    const int numSamples = buffer.getNumSamples();
+    acquireParameters(offlineRequested ? maxExtremeFilterTaps : filterCapacity);
+    
+    // 디지털 무음이 아니면 즉시 깨어남 (컨볼버는 0 상태에서 그대로 이어짐)
+    if (params.bypass || buffer.getMagnitude(0, numSamples) != 0.0f)
+    {
+        silentSamples = 0;
+        idle = false;
+        return false;
+    }
+    
+    if (!idle)
+    {
+        // 이 블록 이전까지의 무음 길이가 꼬리(IR 길이)를 넘고 램프/스무딩이 끝났으면 유휴 진입
+        // warped/hybrid 엔진의 꼬리는 IIR 단의 저역 감쇠 길이, spectral은 프레임 + 출력 지연이라 최대 탭 길이로 충분
+        const int tailLength = juce::jmax((params.engine == FilterEngine::linearPhase ? params.filterTaps : maxFilterTaps)
+                                          + params.getLatencyPadding(), loadedFilterTaps);
+        if (silentSamples < tailLength || convolver.isRamping() || tailConvolver.isRamping() || warpedFilter.isRamping()
+            || shelfFilter.isRamping() || spectralFilter.isRamping() || masterGain.isSmoothing()
+            || pathState != PathState::running || wetMix.isSmoothing())
+        {
+            silentSamples = juce::jmin(silentSamples + numSamples, std::numeric_limits<int>::max() / 2);
+            return false;
+        }
+        
+        // 상태를 0으로 맞춰 두면 깨어날 때 불연속이 없음
+        resetConvolution();
+        idle = true;
+    }
+    
+    // 입력이 이미 0이므로 출력도 그대로 0
+    skippedBlocks.fetch_add(1);
+    return true;
+}
+
+bool LoudnessCompensatorDSP::updateFIRCoefficients(bool mayWait)
+{
+    if (params.engine == FilterEngine::spectral)
+    {
+        designsExecuted.fetch_add(1);
+        updateSpectralGains();
+        return true;
+    }
+    
+    const auto key = makeDesignKey();
+    auto impulseResponse = mayWait ? findDesign(key) : irStore->tryFind(key);
+    const bool found = impulseResponse != nullptr;
+    
+    // 기다려도 되면(prepare, 오프라인 렌더링) 다른 블록 크기의 인스턴스가 설계한 IR의 뒷단도 여기서
+    if (found && mayWait)
+        findOrCreateTail(*impulseResponse);
+    
+    if (impulseResponse == nullptr)
+    {
+        // 점진 설계: 짧은 미리듣기를 바로 적용하고 전체 길이는 설계 스레드에 맡김
+        // 오프라인 렌더링은 처음부터 최종 품질이어야 하므로 여기서 전체 설계
+        const bool preview = progressiveDesign.load() && !offlineRequested && backgroundWorkStarted.load()
+                          && key.filterTaps > previewFilterTaps;
+        const auto designKey = preview ? getPreviewKey(key, previewFilterTaps) : key;
+        bool inFlight = false;
+        
+        // 오디오 스레드는 표준 길이(미리듣기 포함)까지만 설계하고 Extreme 길이는 작업 스레드 풀이 나눠 설계
+        // 그동안 현재 IR을 유지하고 끝나면 collectRefinedDesign이 적용 (오프라인 렌더링은 그 설계를 기다림)
+        if (!isAudioThreadDesign(designKey))
+        {
+            if (mayWait)
+                impulseResponse = findOrDesignInBackground(designKey);
+            else
+                requestBackgroundDesign(designKey);
+        }
+        else
+        {
+            impulseResponse = mayWait ? findOrDesign(designKey, audioDesignArena) : tryFindOrDesign(designKey, inFlight);
+        }
+        
+        // 다른 스레드가 같은 키를 설계 중이면 기다리지 않고 현재 IR 유지 (끝나면 다음 블록에 저장소에서 찾음)
+        if (inFlight)
+            return false;
+        
+        if (preview)
+            requestBackgroundDesign(key);
+    }
+    
+    designsExecuted.fetch_add(1);
+    (found ? designCacheHits : designCacheMisses).fetch_add(1);
+    
+    if (impulseResponse != nullptr)
+        applyImpulseResponse(impulseResponse);
+    
+    return true;
+}
+
+FilterDesignKey LoudnessCompensatorDSP::makeDesignKey() const
+{
+    FilterDesignKey key;
+    key.targetPhon = targetPhon;
+    key.referencePhon = referencePhon;
+    key.filterTaps = getEffectiveFilterTaps();
+    key.sampleRate = currentSampleRate;
+    key.engine = params.engine;
+    
+    // warped/hybrid/spectral 엔진: 고정 탭 수 (governor, 허용 오차 없음)
+    // warped는 계수만 (컨볼버 스펙트럼 없음), 고정 레이턴시는 출력 지연으로
+    // spectral 키는 세션 저장 쪽에 현재 IR이 없음을 알리는 데만 쓰임
+    if (params.engine != FilterEngine::linearPhase)
+    {
+        key.filterTaps = params.getEngineFilterTaps();
+        key.partitionSize = params.engine == FilterEngine::hybrid ? convolver.getPartitionSize() : 0;
+        key.latencyPadding = params.getLatencyPadding();
+        return key;
+    }
+    
+    key.partitionSize = convolver.getPartitionSize();
+    key.responseTolerance = params.responseTolerance;
+    
+    // governor가 탭 수를 낮췄으면 앞에 0을 더 붙여 파라미터가 보고한 레이턴시를 유지
+    key.latencyPadding = params.getLatencyPadding() + params.filterTaps / 2 - key.filterTaps / 2;
+    return key;
+}
+
+SharedImpulseResponse::Ptr LoudnessCompensatorDSP::findDesign(const FilterDesignKey& key)
+{
+    if (auto impulseResponse = irStore->find(key))
+        return impulseResponse;
+    
+    // 세션에서 복원한 계수가 있으면 스펙트럼 변환만
+    if (auto restored = irStore->find(getCoefficientKey(key)))
+        return irStore->insert(new SharedImpulseResponse(key, restored->coefficients, restored->preampGain,
+                                                         restored->iirSections));
+    
+    return nullptr;
+}
+
+SharedImpulseResponse::Ptr LoudnessCompensatorDSP::findOrDesignInBackground(const FilterDesignKey& key)
+{
+    // 같은 인스턴스의 작업 스레드 설계는 arena 하나를 차례로 씀 (작업 스레드이므로 처음 쓸 때 키움)
+    const juce::ScopedLock sl(backgroundDesignLock);
+    reserveDesignArena(backgroundDesignArena, key.filterTaps);
+    return findOrDesign(key, backgroundDesignArena);
+}
+
+void LoudnessCompensatorDSP::reserveDesignArena(DesignArena& arena, int maxTaps, int maxTransformPartitionSize) const
+{
+    // IRFFT 객체는 나누지 않는 길이까지만 (Extreme 길이는 작업 스레드에서만 설계하고 SharedWorkerPool이 나눠 계산)
+    const int maxSerialOrder = juce::roundToInt(std::log2(parallelDesignMinFFTSize)) - 1;
+    const int order = juce::roundToInt(std::log2(2 * juce::nextPowerOfTwo(juce::jmax(1, maxTaps))));
+    
+    // warped 설계는 firwin2 대신 켑스트럼 작업 버퍼를 씀
+    const size_t designBytes = juce::jmax(getDesignArenaBytes(maxTaps, parallelDesignChunkSize),
+                                          static_cast<size_t>(2 * WarpedFIRFilter::designFFTSize) * sizeof(std::complex<float>)
+                                              + static_cast<size_t>(warpedFilterTaps) * sizeof(float) + 64);
+    
+    // 설계 결과를 예비 항목에 채울 때의 스펙트럼 변환 FFT와 작업 버퍼 (오디오 스레드 arena만)
+    const int transformOrder = maxTransformPartitionSize > 0 ? juce::roundToInt(std::log2(2 * maxTransformPartitionSize)) : 0;
+    const size_t transformBytes = static_cast<size_t>(4 * maxTransformPartitionSize) * sizeof(float);
+    
+    arena.reserve(designBytes + transformBytes,
+                  juce::jmax(juce::jmin(order, maxSerialOrder), WarpedFIRFilter::designFFTOrder, transformOrder));
+}
+
+SharedImpulseResponse::Ptr LoudnessCompensatorDSP::findOrDesign(const FilterDesignKey& key, DesignArena& arena)
+{
+    // 같은 설정의 IR이 이미 있으면 빌려 쓰고, 없으면 설계 후 저장소에 등록
+    // 다른 인스턴스/스레드가 같은 키를 설계 중이면 그 결과를 기다려 받음 (설계는 프로세스 전체에서 한 번)
+    auto impulseResponse = findDesign(key);
+    
+    if (impulseResponse == nullptr)
+    {
+        impulseResponse = irStore->findOrCreate(key, [this, &key, &arena]
+        {
+            return createImpulseResponse(key, arena, true);
+        });
+        
+        if (impulseResponse == nullptr)
+            return nullptr;
+    }
+    
+    findOrCreateTail(*impulseResponse);
+    return impulseResponse;
+}
+
+void LoudnessCompensatorDSP::findOrCreateTail(const SharedImpulseResponse& impulseResponse)
+{
+    // 2단 경로의 뒷단 스펙트럼도 설계한 쪽에서 만들어 두면 오디오 스레드는 찾기만 함
+    const int tailPartitionSize = designTailBlockSize.load();
+    if (tailPartitionSize <= 0 || impulseResponse.key.engine == FilterEngine::warped || impulseResponse.key.partitionSize <= 0)
+        return;
+    
+    auto tailKey = impulseResponse.key;
+    tailKey.partitionSize = tailPartitionSize;
+    
+    irStore->findOrCreate(tailKey, [&impulseResponse, &tailKey]() -> SharedImpulseResponse::Ptr
+    {
+        return new SharedImpulseResponse(tailKey, impulseResponse.coefficients, impulseResponse.preampGain);
+    });
+}
+
+SharedImpulseResponse::Ptr LoudnessCompensatorDSP::createImpulseResponse(const FilterDesignKey& key, DesignArena& arena,
+                                                                        bool mayWait, SharedImpulseResponse* spare)
+{
+    // 결과 IR: spare가 있으면 (오디오 스레드) 미리 할당한 항목에 채우고 스펙트럼 변환도 arena의 FFT로
+    auto makeImpulseResponse = [&key, &arena, spare](int padding, const float* coefficients, int numCoefficients, float preamp,
+                                                     const float* iirSections, int numIIRValues) -> SharedImpulseResponse::Ptr
+    {
+        if (spare != nullptr)
+            return spare->assign(key, padding, coefficients, numCoefficients, preamp, iirSections, numIIRValues, arena) ? spare : nullptr;
+        
+        std::vector<float> padded(static_cast<size_t>(padding + numCoefficients), 0.0f);
+        std::copy(coefficients, coefficients + numCoefficients, padded.begin() + padding);
+        return new SharedImpulseResponse(key, std::move(padded), preamp,
+                                         std::vector<float>(iirSections, iirSections + numIIRValues));
+    };
+    
+    arena.reset();
+    
+    // 세션에서 복원한 계수가 있으면 스펙트럼 변환만 (기다리는 경로는 findDesign이 이미 찾아 봄)
+    if (!mayWait)
+    {
+        if (auto restored = irStore->tryFind(getCoefficientKey(key)))
+            return makeImpulseResponse(0, restored->coefficients.data(), static_cast<int>(restored->coefficients.size()),
+                                       restored->preampGain, restored->iirSections.data(),
+                                       static_cast<int>(restored->iirSections.size()));
+    }
+    
+    // 다른 프로세스(샌드박스 호스트)가 이미 설계했으면 계수만 받아 스펙트럼 변환
+    SharedMemoryIRStore::Entry shared;
+    if (sharedMemoryStore->find(key, designVersion, shared))
+        return makeImpulseResponse(0, shared.coefficients, shared.numCoefficients, shared.preampGain,
+                                   shared.iirSections, shared.numIIRValues);
+    
+    // FIR 필터 생성 + RMS offset 보상 (작업 버퍼는 모두 arena, 힙은 저장소에 넣을 결과에만 씀)
+    std::array<float, BiquadCascade::numLowShelfCoefficients> iirSections;
+    int numIIRValues = 0;
+    DesignSpan designed;
+    
+    if (key.engine == FilterEngine::warped)
+    {
+        designed = designWarpedFilter(key, arena);
+    }
+    else if (key.engine == FilterEngine::hybrid)
+    {
+        designed = designHybridFilter(key, iirSections.data(), arena);
+        numIIRValues = static_cast<int>(iirSections.size());
+    }
+    else
+    {
+        designed = designAdaptiveFilter(key, arena);
+    }
+    
+    lastDesignScratchBytes.store(arena.getPeakBytes());
+    float rmsOffset = calculateRMSOffset(key.targetPhon, key.referencePhon);
+    
+    if (designed.empty())
+        return nullptr;
+    
+    // warped 계수는 필터의 출력 지연으로 레이턴시를 맞춤
+    const int padding = key.engine != FilterEngine::warped ? key.latencyPadding : 0;
+    auto impulseResponse = makeImpulseResponse(padding, designed.data, designed.size, -rmsOffset, iirSections.data(), numIIRValues);
+    
+    if (impulseResponse != nullptr)
+        sharedMemoryStore->publish(key, designVersion, impulseResponse->coefficients, -rmsOffset, impulseResponse->iirSections);
+    
+    return impulseResponse;
+}
+
+SharedImpulseResponse::Ptr LoudnessCompensatorDSP::tryFindOrDesign(const FilterDesignKey& key, bool& inFlight)
+{
+    // 저장소를 잡지 못했거나 다른 스레드가 같은 키를 설계 중이면 기다리지 않고 돌아감
+    // 폴링 콜백이 이전 예약을 아직 넘기지 않았거나 예비 항목이 이 키에 모자라면 새로 예약하지 않음 (찾기만)
+    int expected = claimEmpty;
+    if (!claimState.compare_exchange_strong(expected, claimDesigning))
+    {
+        auto impulseResponse = irStore->tryFind(key);
+        inFlight = impulseResponse == nullptr;
+        return impulseResponse;
+    }
+    
+    // 계수는 최대 탭 수 + 레이턴시 패딩, Extreme 단계는 뒷단 스펙트럼도 예비 항목에
+    const int maxCoefficients = key.latencyPadding + key.filterTaps;
+    const int partitionSize = key.engine != FilterEngine::warped ? key.partitionSize : 0;
+    const int tailPartitionSize = partitionSize > 0 ? designTailBlockSize.load() : 0;
+    const bool sparesFit = spareClaim != nullptr && spareDesign != nullptr
+                        && spareDesign->hasCapacity(maxCoefficients, partitionSize)
+                        && (tailPartitionSize <= 0 || (spareTail != nullptr && spareTail->hasCapacity(maxCoefficients, tailPartitionSize)));
+    
+    bool claimed = false;
+    auto impulseResponse = sparesFit ? irStore->tryFindOrClaim(key, spareClaim, claimed) : irStore->tryFind(key);
+    inFlight = impulseResponse == nullptr && !claimed;
+    
+    if (!claimed)
+    {
+        claimState.store(claimEmpty);
+        return impulseResponse;
+    }
+    
+    // 예약한 키는 예비 항목에 설계해 바로 적용하고, 등록은 폴링 콜백이 (그 전에 지워지지 않도록 참조를 넘김)
+    // 쓴 예비 항목은 넘기고 폴링 콜백이 새로 만듦 (오디오 스레드는 할당도 해제도 하지 않음)
+    impulseResponse = createImpulseResponse(key, audioDesignArena, false, spareDesign.get());
+    claimedTail = nullptr;
+    
+    if (impulseResponse != nullptr)
+    {
+        spareDesign = nullptr;
+        
+        auto tailKey = key;
+        tailKey.partitionSize = tailPartitionSize;
+        
+        if (tailPartitionSize > 0
+            && spareTail->assign(tailKey, 0, impulseResponse->coefficients.data(), static_cast<int>(impulseResponse->coefficients.size()),
+                                 impulseResponse->preampGain, nullptr, 0, audioDesignArena))
+            claimedTail = std::move(spareTail);
+    }
+    
+    claimedDesign.key = key;
+    claimedDesign.impulseResponse = impulseResponse;
+    claimedDesign.tail = claimedTail;
+    claimState.store(claimReady);
+    return impulseResponse;
+}
+
+void LoudnessCompensatorDSP::completeClaimedDesign()
+{
+    // 폴링 콜백과 소멸자 중 한쪽만 넘김
+    int expected = claimReady;
+    if (!claimState.compare_exchange_strong(expected, claimCompleting))
+        return;
+    
+    // 뒷단을 먼저 등록해야 깨어난 스레드가 같은 뒷단을 다시 만들지 않음
+    if (claimedDesign.tail != nullptr)
+        irStore->insert(std::move(claimedDesign.tail));
+    
+    irStore->completeClaim(claimedDesign.key, std::move(claimedDesign.impulseResponse));
+    claimedDesign.tail = nullptr;
+    claimedDesign.impulseResponse = nullptr;
+    claimState.store(claimEmpty);
+}
+
+void LoudnessCompensatorDSP::prepareClaimSpares()
+{
+    // 오디오 스레드가 예비 항목을 쓰는 중이거나 넘길 예약이 남아 있으면 다음 폴링에
+    int expected = claimEmpty;
+    if (!claimState.compare_exchange_strong(expected, claimCompleting))
+        return;
+    
+    // 계수는 오디오 스레드가 설계하는 표준 최대 탭까지 (고정 레이턴시 패딩을 더해도 넘지 않음), 스펙트럼은 지금 파티션 크기로
+    // 파티션 크기가 바뀌었으면 새로 만듦 (그 전까지 오디오 스레드는 예약하지 않고 찾기만)
+    const int capacity = maxFilterTaps;
+    const int partitionSize = preparedPartitionSize.load();
+    const int tailPartitionSize = designTailBlockSize.load();
+    
+    if (spareDesign == nullptr || !spareDesign->hasCapacity(capacity, partitionSize))
+        spareDesign = new SharedImpulseResponse(capacity, BiquadCascade::numLowShelfCoefficients, partitionSize);
+    
+    if (tailPartitionSize <= 0)
+        spareTail = nullptr;
+    else if (spareTail == nullptr || !spareTail->hasCapacity(capacity, tailPartitionSize))
+        spareTail = new SharedImpulseResponse(capacity, 0, tailPartitionSize);
+    
+    if (spareClaim == nullptr)
+        spareClaim = SharedIRStore::makeClaim();
+    
+    designSpareBytes.store(spareDesign->getMemoryUsage() + (spareTail != nullptr ? spareTail->getMemoryUsage() : 0));
+    claimState.store(claimEmpty);
+}
+
+void LoudnessCompensatorDSP::applyImpulseResponse(const SharedImpulseResponse::Ptr& impulseResponse)
+{
+    // 실시간 2단은 앞단이 뒷단 블록 길이까지만 담으므로, 뒷단 스펙트럼이 아직 없으면(블록 크기가 다른 인스턴스가
+    // 설계했거나 저장소를 잡지 못함) 들리는 필터를 유지하고 작업 스레드에 맡김 (끝나면 collectRefinedDesign이 적용)
+    if (realtimeTwoStage && filterReady && needsTail(*impulseResponse) && findTail(*impulseResponse) == nullptr)
+    {
+        requestBackgroundDesign(impulseResponse->key);
+        return;
+    }
+    
+    // Convolver에 적용
+    // 레이턴시가 같으면(고정 레이턴시 모드의 품질 변경 포함) 파티션 계수를 램프, 아니면 즉시 교체
+    const auto& key = impulseResponse->key;
+    const bool warped = key.engine == FilterEngine::warped;
+    const int latency = warped ? key.latencyPadding : key.filterTaps / 2 + key.latencyPadding;
+    const bool engineChanged = spectralActive || (currentIR != nullptr && currentIR->key.engine != key.engine);
+    const bool ramp = latency == loadedLatency && !engineChanged;
+    
+    // 엔진이 바뀌거나 warped 출력 지연이 바뀌면 새 경로를 입력 이력으로 채워야 함
+    // 들리는 경로면 페이드아웃이 끝날 때까지 지금 경로를 그대로 두고 마지막 설계만 기억
+    const bool needsPriming = engineChanged || (warped && !ramp);
+    if (needsPriming && deferPathSwitch())
+    {
+        pendingSwitchIR = impulseResponse;
+        pendingSpectralSwitch = false;
+        return;
+    }
+    
+    // 지금 경로와 맞는 설계면 미뤄 둔 엔진 전환은 취소 (페이드아웃 중에 되돌린 경우)
+    if (!needsPriming)
+        cancelPathSwitch();
+    
+    preampGain = impulseResponse->preampGain;
+    spectralActive = false;
+    loadImpulseResponse(impulseResponse, ramp);
+    
+    // 이전 IR은 저장소가 계속 참조하므로 여기서 해제되지 않음
+    currentIR = impulseResponse;
+    loadedFilterTaps = static_cast<int>(impulseResponse->coefficients.size());
+    loadedLatency = latency;
+    
+    if (needsPriming)
+        startPriming();
+    
+    // 상태 저장 쪽에서 현재 IR을 찾을 수 있도록 키 발행
+    appliedDesignKeys.getWriteBuffer() = impulseResponse->key;
+    appliedDesignKeys.publish();
+}
+
+SharedImpulseResponse::Ptr LoudnessCompensatorDSP::getCurrentDesign()
+{
+    const juce::ScopedLock sl(designKeyReadLock);
+    
+    if (appliedDesignKeys.acquire())
+        hasAppliedDesign = true;
+    
+    // 저장소에서 다시 찾으므로 오디오 스레드의 currentIR에는 손대지 않음
+    return hasAppliedDesign ? irStore->find(appliedDesignKeys.getReadBuffer()) : nullptr;
+}
+
+void LoudnessCompensatorDSP::restoreDesign(const FilterDesignKey& key, std::vector<float> coefficients, float preamp,
+                                           std::vector<float> iirSections)
+{
+    // 파티션 크기와 무관한 계수 항목으로 등록 (prepare/재설계 시 키가 맞으면 설계 대신 사용)
+    // 저장소가 정리해도 사라지지 않도록 이 인스턴스가 참조를 유지
+    restoredDesign = irStore->insert(new SharedImpulseResponse(getCoefficientKey(key), std::move(coefficients), preamp,
+                                                               std::move(iirSections)));
+    
+    // 재생 중에 복원했으면 스펙트럼 변환을 작업 스레드에서 미리 해 둠 (오디오 스레드는 찾기만 함)
+    // prepare 전이면 prepare가 변환하고, warped 계수는 변환할 것이 없음
+    const int partitionSize = preparedPartitionSize.load();
+    if (partitionSize > 0 && key.engine != FilterEngine::warped)
+    {
+        auto spectraKey = key;
+        spectraKey.partitionSize = partitionSize;
+        
+        designJobs->addJob(SharedWorkerPool::Priority::loading, [this, spectraKey]
+        {
+            findOrDesignInBackground(spectraKey);
+        });
+    }
+}
+
+void LoudnessCompensatorDSP::loadImpulseResponse(const SharedImpulseResponse::Ptr& impulseResponse, bool rampCoefficients)
+{
+    const int rampBlocks = rampCoefficients ? filterRampBlocks : 0;
+    
+    // warped 엔진은 오프라인에서도 같은 경로 (2단 분할 이득 없음)
+    if (impulseResponse->key.engine == FilterEngine::warped)
+    {
+        warpedFilter.setCoefficients(impulseResponse->coefficients, rampBlocks * convolver.getPartitionSize());
+        warpedFilter.setDelay(impulseResponse->key.latencyPadding);
+        sharedIRBytes.store(impulseResponse->getMemoryUsage());
+        return;
+    }
+    
+    // hybrid: shelf 단은 FIR 계수 램프와 같은 길이로 크로스페이드, FIR 부분은 아래 컨볼버 경로 그대로
+    if (impulseResponse->key.engine == FilterEngine::hybrid)
+        shelfFilter.setSections(impulseResponse->iirSections, rampBlocks * convolver.getPartitionSize());
+    
+    if (!isTwoStage())
+    {
+        convolver.setTargetImpulseSpectra(impulseResponse->getSpectra(), impulseResponse->getNumPartitions(),
+                                          rampBlocks, impulseResponse->getFirstPartition());
+        sharedIRBytes.store(impulseResponse->getMemoryUsage());
+        return;
+    }
+    
+    // 뒷단 스펙트럼은 설계 스레드가 앞단과 함께 만들어 둠
+    // 아직 없으면 여기서 변환하지 않고 앞단이 담을 수 있는 만큼 단일 단으로 처리
+    // 오프라인 2단은 앞단이 전체 길이를 담으므로 결과가 같고 다음 설계부터 2단 (마감이 없으므로 연산량만 늘어남)
+    // 실시간 2단은 앞단이 잘리므로 작업 스레드에 맡기고, 끝나면 collectRefinedDesign이 다시 적용
+    // 앞단에 다 들어가는 IR은 뒷단이 필요 없음
+    const auto tail = needsTail(*impulseResponse) ? findTail(*impulseResponse) : nullptr;
+    
+    if (tail == nullptr)
+    {
+        if (realtimeTwoStage && needsTail(*impulseResponse))
+            requestBackgroundDesign(impulseResponse->key);
+        
+        // 뒷단은 0 파티션으로 (스펙트럼이 없으면 입력을 통과시키므로 읽지 않는 포인터라도 넘김)
+        // 0 출력으로 입력 이력을 계속 유지하므로 뒷단이 도착하면 그대로 이어짐
+        convolver.setTargetImpulseSpectra(impulseResponse->getSpectra(), impulseResponse->getNumPartitions(),
+                                          rampBlocks, impulseResponse->getFirstPartition());
+        tailConvolver.setTargetImpulseSpectra(impulseResponse->getSpectra(), 0, rampBlocks);
+        tailIR = nullptr;
+        sharedIRBytes.store(impulseResponse->getMemoryUsage());
+        return;
+    }
+    
+    // 앞단: 같은 IR의 앞쪽 파티션만 사용 (tailBlockSize 구간)
+    const int partitionSize = convolver.getPartitionSize();
+    const int headPartitions = juce::jmin(impulseResponse->getNumPartitions(), tailBlockSize / partitionSize);
+    convolver.setTargetImpulseSpectra(impulseResponse->getSpectra(), headPartitions, rampBlocks,
+                                      juce::jmin(impulseResponse->getFirstPartition(), headPartitions));
+    
+    // 뒷단: tailBlockSize 파티션으로 변환한 같은 IR의 두 번째 파티션부터
+    const int tailPartitions = tail->getNumPartitions() - 1;
+    const auto* tailSpectra = tail->getSpectra() + (tailPartitions > 0 ? tailBlockSize + 1 : 0);
+    
+    // 뒷단은 블록 경계에서만 계수가 바뀌므로 앞단과 같은 단계 수로 (더 길게) 램프
+    tailConvolver.setTargetImpulseSpectra(tailSpectra, juce::jmax(0, tailPartitions), rampBlocks,
+                                          juce::jmax(0, tail->getFirstPartition() - 1));
+    tailIR = tail;
+    
+    sharedIRBytes.store(impulseResponse->getMemoryUsage() + tail->getMemoryUsage());
+}
+
+bool LoudnessCompensatorDSP::needsTail(const SharedImpulseResponse& impulseResponse) const
 {
-    loadISOData();
+    return isTwoStage() && impulseResponse.key.engine != FilterEngine::warped
+        && impulseResponse.getNumPartitions() > tailBlockSize / convolver.getPartitionSize();
 }
 
-LoudnessCompensatorDSP::~LoudnessCompensatorDSP()
+SharedImpulseResponse::Ptr LoudnessCompensatorDSP::findTail(const SharedImpulseResponse& impulseResponse) const
 {
+    // 저장소를 잡지 못하면 기다리지 않고 없는 것으로 (오디오 스레드가 방금 설계했으면 등록 전의 예약 결과)
+    auto key = impulseResponse.key;
+    key.partitionSize = tailBlockSize;
+    
+    auto tail = irStore->tryFind(key);
+    if (tail == nullptr && claimedTail != nullptr && claimedTail->key == key)
+        tail = claimedTail;
+    
+    return tail;
 }
 
-void LoudnessCompensatorDSP::setEasyLoudness(float value)
+void LoudnessCompensatorDSP::requestBackgroundDesign(const FilterDesignKey& key)
 {
-    easyLoudness = juce::jlimit(20.0f, 70.0f, value);
+    // 점진 설계의 전체 길이, Extreme 길이 설계, 빠진 뒷단 스펙트럼 모두 같은 경로
+    // 작업 스레드의 findOrDesign이 저장소에 있으면 뒷단만 변환하고, 없으면 설계해서 돌려줌
+    refinementRequests.getWriteBuffer() = key;
+    refinementRequests.publish();
+}
+
+void LoudnessCompensatorDSP::convolve(juce::dsp::AudioBlock<float>& block)
+{
+    // spectral 엔진은 STFT만 (오프라인에서도 같은 경로)
+    if (spectralActive)
+    {
+        spectralFilter.process(juce::dsp::ProcessContextReplacing<float>(block));
+        return;
+    }
     
-    // Easy Loudness (20-70) → Target Phon (20-70)
-    targetPhon = easyLoudness;
+    const auto engine = currentIR != nullptr ? currentIR->key.engine : FilterEngine::linearPhase;
     
-    // Expert Mode가 아닐 때만 적응형 파라미터 적용
-    if (!expertMode)
+    if (engine == FilterEngine::warped)
     {
-        calculateAdaptiveParameters();
+        warpedFilter.process(juce::dsp::ProcessContextReplacing<float>(block));
+        return;
     }
     
-    // Reference Phon 계산 (exponential decay)
-    const float deltaMin = 1.0f;
-    float gap = deltaMin + (deltaMax - deltaMin) * std::exp(-(targetPhon - 20.0f) / kValue);
+    if (engine == FilterEngine::hybrid)
+        shelfFilter.process(juce::dsp::ProcessContextReplacing<float>(block));
     
-    // Expert Mode가 아닐 때 페이드아웃 및 헤드룸 보호 적용
-    if (!expertMode)
+    if (isTwoStage())
+        convolveTwoStage(block);
+    else
+        convolver.process(juce::dsp::ProcessContextReplacing<float>(block));
+}
+
+void LoudnessCompensatorDSP::convolveTwoStage(juce::dsp::AudioBlock<float>& block)
+{
+    const int numSamples = static_cast<int>(block.getNumSamples());
+    const int numChannels = juce::jmin(static_cast<int>(block.getNumChannels()), tailInput.getNumChannels());
+    
+    int processed = 0;
+    
+    while (processed < numSamples)
     {
-        // 페이드아웃 (80-85 phon)
-        float fadeScale = 1.0f;
-        if (targetPhon >= 80.0f && targetPhon < 85.0f)
-        {
-            fadeScale = 1.0f - (targetPhon - 80.0f) / 5.0f;
-        }
-        else if (targetPhon >= 85.0f)
-        {
-            fadeScale = 0.0f;
-        }
+        const int count = juce::jmin(numSamples - processed, tailBlockSize - tailPosition);
+        auto chunk = block.getSubBlock(static_cast<size_t>(processed), static_cast<size_t>(count));
         
-        // 헤드룸 보호 (70 phon 이상)
-        float headroomScale = 1.0f;
-        if (targetPhon > 70.0f)
+        // 뒷단 입력은 앞단이 덮어쓰기 전에 복사
+        for (int ch = 0; ch < numChannels; ++ch)
+            tailInput.copyFrom(ch, tailPosition, chunk.getChannelPointer(static_cast<size_t>(ch)), count);
+        
+        convolver.process(juce::dsp::ProcessContextReplacing<float>(chunk));
+        
+        // 이전 블록에서 계산한 뒷단 출력 (tailBlockSize만큼 늦게 시작하는 IR 뒷부분이므로 정확히 제 시간)
+        for (int ch = 0; ch < numChannels; ++ch)
+            juce::FloatVectorOperations::add(chunk.getChannelPointer(static_cast<size_t>(ch)),
+                                             tailOutput.getReadPointer(ch, tailPosition), count);
+        
+        tailPosition += count;
+        processed += count;
+        
+        // 뒷단 블록 완료: 큰 FFT 한 번으로 다음 블록 출력 계산
+        if (tailPosition == tailBlockSize)
         {
-            headroomScale = 1.0f - 0.3f * (targetPhon - 70.0f) / 20.0f;
-            headroomScale = juce::jmax(0.7f, headroomScale);
+            tailPosition = 0;
+            
+            auto tailBlock = juce::dsp::AudioBlock<float>(tailInput).getSubsetChannelBlock(0, static_cast<size_t>(numChannels));
+            tailConvolver.process(juce::dsp::ProcessContextReplacing<float>(tailBlock));
+            
+            for (int ch = 0; ch < numChannels; ++ch)
+                tailOutput.copyFrom(ch, 0, tailInput, ch, 0, tailBlockSize);
         }
-        
-        gap *= fadeScale * headroomScale;
+    }
+}
+
+void LoudnessCompensatorDSP::switchRenderPath(bool offline)
+{
+    const bool wasTwoStage = isTwoStage();
+    const bool twoStage = tailBlockSize > 0 && (offline || realtimeTwoStage);
+    
+    // 오프라인에서 돌아오며 들리는 경로를 바꾸면 페이드아웃이 끝난 뒤에 (그동안 매 블록 여기로 다시 옴)
+    if (twoStage != wasTwoStage && currentIR != nullptr && !spectralActive && deferPathSwitch())
+    {
+        pendingRenderSwitch = true;
+        return;
+    }
+    
+    offlineActive = offline;
+    designTailBlockSize.store(isTwoStage() ? tailBlockSize : 0);
+    
+    // 실시간에도 2단인 Extreme 길이는 경로가 그대로
+    if (isTwoStage() == wasTwoStage)
+        return;
+    
+    if (isTwoStage())
+    {
+        // 뒷단 버퍼는 처음 오프라인에 들어갈 때 할당
+        allocateTailStage();
+    }
+    else
+    {
+        // 저장소가 참조를 들고 있으므로 여기서 해제되지 않음
+        tailConvolver.setImpulseSpectra(nullptr, 0);
+        tailIR = nullptr;
     }
     
-    referencePhon = targetPhon + gap;
-    referencePhon = juce::jmax(referencePhon, targetPhon + 0.1f);
+    // spectral 엔진은 오프라인에서도 같은 경로
+    if (currentIR == nullptr || spectralActive)
+        return;
     
-    coefficientsNeedUpdate = true;
+    // 램프 없이 현재 IR을 새 경로에 배치하고 입력 이력으로 상태를 채워 이음새 없이 이어감
+    loadImpulseResponse(currentIR, false);
+    startPriming();
 }
 
-void LoudnessCompensatorDSP::setBypass(bool shouldBypass)
+void LoudnessCompensatorDSP::prepareConvolution(int partitionSize)
 {
-    bypass = shouldBypass;
+    // 뒷단 블록 크기: 앞단/뒷단 연산량이 비슷해지는 sqrt(taps * partition) 근처
+    // 파티션이 이미 크면 파티션 수가 적어 큰 FFT 비용이 곱셈 절약보다 커지므로 2단 분할하지 않음
+    // 단, Extreme 길이로 균일 파티션이 maxUniformPartitions를 넘으면 실시간에도 2단
+    // (그 이하에서는 뒷단의 큰 FFT 때문에 균일 파티션이 더 쌈)
+    realtimeTwoStage = filterCapacity > maxUniformPartitions * partitionSize;
+    tailBlockSize = 0;
+    if (partitionSize <= maxTwoStagePartitionSize || realtimeTwoStage)
+        tailBlockSize = juce::nextPowerOfTwo(static_cast<int>(std::sqrt(static_cast<double>(filterCapacity) * partitionSize)));
+    if (tailBlockSize >= filterCapacity)
+        tailBlockSize = 0;
+    
+    realtimeTwoStage = realtimeTwoStage && tailBlockSize > 0;
+    designTailBlockSize.store(isTwoStage() ? tailBlockSize : 0);
+    
+    // 실시간 2단이면 앞단은 뒷단 블록 길이까지만 맡음 (오프라인 2단은 전환 전에도 쓰므로 전체 길이)
+    convolver.prepare(partitionSize, realtimeTwoStage ? tailBlockSize : filterCapacity, 2, filterRampBlocks > 0);
+    
+    // 뒷단 버퍼는 실제로 2단 경로에 들어갈 때 할당
+    tailIR = nullptr;
+    tailConvolver.release();
+    tailInput.setSize(0, 0);
+    tailOutput.setSize(0, 0);
+    tailPosition = 0;
+    
+    if (isTwoStage())
+        allocateTailStage();
+    
+    // 이력은 바이패스 지연(최대 레이턴시 + 블록)과, 새 경로를 채우는 동안 밀린 이력(채울 길이나 한 블록 중 긴 쪽) + 블록보다
+    // 긴 2의 거듭제곱 길이 (같으면 밀린 길이를 위치 차이로 구할 수 없음)
+    const int primeBacklog = juce::jmax(juce::nextPowerOfTwo(filterCapacity), preparedBlockSize);
+    inputHistory.setSize(2, juce::nextPowerOfTwo(primeBacklog + preparedBlockSize + 1));
+    inputHistory.clear();
+    primeScratch.setSize(2, partitionSize);
+    historyPosition = 0;
+    primePosition = 0;
 }
 
-void LoudnessCompensatorDSP::setKValue(float k)
+void LoudnessCompensatorDSP::allocateTailStage()
 {
-    kValue = juce::jlimit(5.0f, 30.0f, k);
-    setEasyLoudness(easyLoudness); // 재계산
+    if (tailInput.getNumChannels() > 0)
+        return;
+    
+    tailConvolver.prepare(tailBlockSize, filterCapacity - tailBlockSize, 2, filterRampBlocks > 0);
+    tailInput.setSize(2, tailBlockSize);
+    tailOutput.setSize(2, tailBlockSize);
 }
 
-void LoudnessCompensatorDSP::setDeltaMax(float delta)
+bool LoudnessCompensatorDSP::needsFilterCapacity() const
 {
-    deltaMax = juce::jlimit(10.0f, 40.0f, delta);
-    setEasyLoudness(easyLoudness); // 재계산
+    return publishedEngineFilterTaps.load() > publishedFilterCapacity.load();
 }
 
-void LoudnessCompensatorDSP::setFilterTaps(int taps)
+void LoudnessCompensatorDSP::growFilterCapacity()
 {
-    filterTaps = taps;
-    coefficientsNeedUpdate = true;
+    // prepare 전이면 prepare가 발행된 파라미터 기준으로 할당
+    if (preparedPartitionSize.load() == 0 || !needsFilterCapacity())
+        return;
+    
+    acquireParameters(maxExtremeFilterTaps);
+    resizeFilterCapacity();
 }
 
-void LoudnessCompensatorDSP::setExpertMode(bool expert)
+void LoudnessCompensatorDSP::resizeFilterCapacity()
 {
-    expertMode = expert;
-    setEasyLoudness(easyLoudness); // 재계산
+    // 레이턴시가 바뀌는 전환이라 어차피 이음새가 생기므로 이력/상태는 새로 시작
+    filterCapacity = juce::jlimit(maxFilterTaps, maxExtremeFilterTaps, juce::jmax(filterCapacity, params.getEngineFilterTaps()));
+    publishedFilterCapacity.store(filterCapacity);
+    prepareConvolution(convolver.getPartitionSize());
+    reserveDesignArena(audioDesignArena, maxFilterTaps, juce::jmax(convolver.getPartitionSize(), tailBlockSize));
+    loadedFilterTaps = 0;
+    loadedLatency = -1;
+    
+    // 새 설계가 적용될 때까지 지금 IR을 새 경로에 다시 배치
+    if (currentIR != nullptr && !spectralActive)
+        loadImpulseResponse(currentIR, false);
 }
 
-void LoudnessCompensatorDSP::prepare(double sampleRate, int maximumBlockSize)
+void LoudnessCompensatorDSP::pushInputHistory(const juce::AudioBuffer<float>& buffer)
 {
-    currentSampleRate = sampleRate;
+    const int historySize = inputHistory.getNumSamples();
+    const int numChannels = juce::jmin(buffer.getNumChannels(), inputHistory.getNumChannels());
+    
+    if (historySize == 0)
+        return;
     
-    // Convolution 준비
-    juce::dsp::ProcessSpec spec;
-    spec.sampleRate = sampleRate;
-    spec.maximumBlockSize = static_cast<juce::uint32>(maximumBlockSize);
-    spec.numChannels = 2;
+    // 이력보다 긴 블록은 마지막 historySize 샘플만 의미 있음
+    const int count = juce::jmin(buffer.getNumSamples(), historySize);
+    const int offset = buffer.getNumSamples() - count;
+    const int first = juce::jmin(count, historySize - historyPosition);
     
-    convolution.prepare(spec);
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        inputHistory.copyFrom(ch, historyPosition, buffer, ch, offset, first);
+        
+        if (count > first)
+            inputHistory.copyFrom(ch, 0, buffer, ch, offset + first, count - first);
+    }
     
-    // 초기 FIR 계수 계산
-    updateFIRCoefficients();
+    historyPosition = (historyPosition + count) % historySize;
 }
 
-void LoudnessCompensatorDSP::process(juce::AudioBuffer<float>& buffer)
+void LoudnessCompensatorDSP::startPriming()
 {
-    if (bypass)
-        return;
-    
-    // FIR 계수 업데이트 필요 시
-    if (coefficientsNeedUpdate)
+    convolver.reset();
+    warpedFilter.reset();
+    shelfFilter.reset();
+    spectralFilter.reset();
+    tailConvolver.reset();
+    tailInput.clear();
+    tailOutput.clear();
+    tailPosition = 0;
+    
+    // 이번 블록을 넣기 전의 최근 primeLength 샘플부터 흘려 보냄 (process가 블록마다 나눠서)
+    // 최대 IR 길이 이상이므로 따라잡은 뒤의 출력은 전환이 없었을 때와 같고,
+    // 파티션/뒷단 블록의 배수이므로 따라잡은 뒤 블록 경계가 호스트 블록과 맞음
+    const int historySize = inputHistory.getNumSamples();
+    const int primeLength = juce::jmin(historySize, juce::nextPowerOfTwo(filterCapacity));
+    primePosition = (historyPosition + historySize - primeLength) % historySize;
+    pathState = PathState::priming;
+}
+
+bool LoudnessCompensatorDSP::advancePriming(int numSamples)
+{
+    // 방금 넣은 블록 앞까지 밀린 이력을 블록 길이의 primingBlocksPerBlock배까지만 흘려 보내고 출력은 버림
+    // 오프라인 렌더링은 마감이 없으므로 한 번에
+    const int historySize = inputHistory.getNumSamples();
+    const int chunkSize = primeScratch.getNumSamples();
+    const int behind = (historyPosition + historySize - primePosition) % historySize - numSamples;
+    const int primeCount = offlineRequested ? behind : juce::jmin(behind, primingBlocksPerBlock * numSamples);
+    
+    for (int done = 0; done < primeCount;)
     {
-        updateFIRCoefficients();
-        coefficientsNeedUpdate = false;
+        const int count = juce::jmin(chunkSize, primeCount - done, historySize - primePosition);
+        
+        for (int ch = 0; ch < primeScratch.getNumChannels(); ++ch)
+            primeScratch.copyFrom(ch, 0, inputHistory, ch, primePosition, count);
+        
+        auto block = juce::dsp::AudioBlock<float>(primeScratch).getSubBlock(0, static_cast<size_t>(count));
+        convolve(block);
+        
+        primePosition = (primePosition + count) % historySize;
+        done += count;
     }
     
-    // JUCE DSP 블록으로 변환
-    juce::dsp::AudioBlock<float> block(buffer);
-    juce::dsp::ProcessContextReplacing<float> context(block);
-    
-    // Convolution 처리
-    convolution.process(context);
-    
-    // Master Gain 적용 (-3dB + preamp + 헤드룸/페이드아웃 보정)
-    float masterGainDB = getMasterGain();
-    float linearGain = std::pow(10.0f, masterGainDB / 20.0f);
+    if (primeCount < behind)
+        return false;
     
-    buffer.applyGain(linearGain);
+    pathState = PathState::running;
+    return true;
 }
 
-void LoudnessCompensatorDSP::reset()
+bool LoudnessCompensatorDSP::deferPathSwitch()
 {
-    convolution.reset();
+    // 원신호만 나가고 있으면(첫 설계 전, 바이패스, 채우는 중) 바로 바꿈
+    // 오프라인 렌더링도 원신호가 섞이면 안 되므로 바로
+    const bool wetSilent = wetMix.getCurrentValue() == 0.0f && wetMix.getTargetValue() == 0.0f;
+    if (offlineRequested || !filterReady || pathState == PathState::priming
+        || (pathState == PathState::running && wetSilent))
+        return false;
+    
+    // 지금 경로는 그대로 돌리며 원신호로 페이드아웃 (끝나면 process가 applyPendingPathSwitch 호출)
+    pathState = PathState::fadingOut;
+    return true;
 }
 
-void LoudnessCompensatorDSP::updateFIRCoefficients()
+void LoudnessCompensatorDSP::cancelPathSwitch()
 {
-    // FIR 필터 생성
-    firCoefficients = generateFIRFilter(targetPhon, referencePhon);
+    pendingSwitchIR = nullptr;
+    pendingSpectralSwitch = false;
     
-    // RMS offset 계산
-    float rmsOffset = calculateRMSOffset(targetPhon, referencePhon);
-    preampGain = -rmsOffset; // 보상
+    // 실시간 경로 전환이 남아 있으면 페이드아웃을 계속함
+    if (pathState == PathState::fadingOut && !pendingRenderSwitch)
+        pathState = PathState::running;
+}
+
+void LoudnessCompensatorDSP::applyPendingPathSwitch()
+{
+    // 원신호 쪽이므로 아래 전환은 미루지 않고 바로 적용됨
+    pathState = PathState::priming;
     
-    // JUCE Convolution에 적용
-    if (!firCoefficients.empty())
-    {
-        // AudioBuffer로 변환
-        juce::AudioBuffer<float> irBuffer(1, static_cast<int>(firCoefficients.size()));
-        irBuffer.copyFrom(0, 0, firCoefficients.data(), static_cast<int>(firCoefficients.size()));
-        
-        // Convolution 로드
-        convolution.loadImpulseResponse(std::move(irBuffer), currentSampleRate, 
-                                       juce::dsp::Convolution::Stereo::yes, 
-                                       juce::dsp::Convolution::Trim::no,
-                                       juce::dsp::Convolution::Normalise::no);
-    }
+    if (pendingRenderSwitch)
+        switchRenderPath(offlineRequested);
+    
+    if (pendingSwitchIR != nullptr)
+        applyImpulseResponse(pendingSwitchIR);
+    else if (pendingSpectralSwitch)
+        updateSpectralGains();
+    
+    pendingSwitchIR = nullptr;
+    pendingSpectralSwitch = false;
+    pendingRenderSwitch = false;
+    
+    // 바이패스 해제처럼 전환이 없어도 멈춰 있던 경로는 이력으로 다시 채움
+    startPriming();
 }
 
-std::vector<float> LoudnessCompensatorDSP::generateFIRFilter(float targetPhon, float referencePhon)
+DesignSpan LoudnessCompensatorDSP::generateFIRFilter(float targetPhon, float referencePhon,
+                                                   int numTaps, double sampleRate, DesignArena& arena)
 {
     // ISO gain 계산
-    std::vector<float> gainsDB = calculateISOGains(targetPhon, referencePhon);
+    const auto gainsDB = calculateISOGains(targetPhon, referencePhon);
     
     // Linear gain으로 변환
-    std::vector<float> gainsLinear(gainsDB.size());
+    ISOGains gainsLinear;
     for (size_t i = 0; i < gainsDB.size(); ++i)
     {
         gainsLinear[i] = std::pow(10.0f, gainsDB[i] / 20.0f);
     }
     
     // 정규화된 주파수 (0-1)
-    std::vector<float> normalizedFreq;
-    float nyquist = currentSampleRate / 2.0f;
-    for (float freq : ISO226::FREQUENCIES)
+    ISOGains normalizedFreq;
+    float nyquist = static_cast<float>(sampleRate) / 2.0f;
+    for (int i = 0; i < ISO226::NUM_FREQUENCIES; ++i)
     {
-        normalizedFreq.push_back(freq / nyquist);
+        normalizedFreq[static_cast<size_t>(i)] = ISO226::FREQUENCIES[i] / nyquist;
     }
     
     // Firwin2 호출
-    return firwin2(filterTaps, normalizedFreq, gainsLinear, currentSampleRate);
+    return firwin2(numTaps, normalizedFreq.data(), gainsLinear.data(), ISO226::NUM_FREQUENCIES,
+                   static_cast<float>(sampleRate), arena);
+}
+
+DesignSpan LoudnessCompensatorDSP::designAdaptiveFilter(const FilterDesignKey& key, DesignArena& arena)
+{
+    const int maxTaps = key.filterTaps;
+    
+    if (key.responseTolerance <= 0.0f || maxTaps < minAdaptiveFilterTaps)
+        return generateFIRFilter(key.targetPhon, key.referencePhon, maxTaps, key.sampleRate, arena);
+    
+    // 결과는 maxTaps 길이 필터와 중심(레이턴시)이 같도록 앞에 0을 붙이고, 뒤쪽 0은 붙이지 않음
+    // (앞쪽 0 파티션은 컨볼버가 건너뛰고 뒤쪽은 파티션 수 자체가 줄어듦)
+    const int maxCentre = (maxTaps - 1) / 2;
+    const auto gainsDB = calculateISOGains(key.targetPhon, key.referencePhon);
+    
+    // 곡선이 허용 오차 안에서 평탄하면 레이턴시만 맞춘 단위 임펄스 (순수 지연)
+    const float identity = 1.0f;
+    if (measureResponseError(&identity, 1, gainsDB.data(), key.sampleRate) <= key.responseTolerance)
+    {
+        auto delayed = arena.allocateSpan(maxCentre + 1);
+        if (delayed.data == nullptr)
+            return {};
+        
+        std::fill(delayed.begin(), delayed.end(), 0.0f);
+        delayed[maxCentre] = identity;
+        return delayed;
+    }
+    
+    // 짧은 후보부터 설계해서 허용 오차를 처음 만족하는 길이 사용 (마지막 후보는 maxTaps 그대로)
+    // 후보 길이가 두 배씩 늘어나므로 전체 비용은 maxTaps 설계 한 번의 두 배 이하
+    // 탈락한 후보의 작업 버퍼는 다음 후보가 다시 쓰므로 arena는 가장 긴 후보 하나 크기면 충분
+    for (int taps = minAdaptiveFilterTaps;; taps = taps * 2 + 1)
+    {
+        const int numTaps = juce::jmin(taps, maxTaps);
+        const auto mark = arena.getMark();
+        auto coefficients = generateFIRFilter(key.targetPhon, key.referencePhon, numTaps, key.sampleRate, arena);
+        
+        if (coefficients.empty())
+            return coefficients;
+        
+        const int trimmed = trimNegligibleTails(coefficients);
+        
+        if (numTaps == maxTaps
+            || measureResponseError(coefficients.data, coefficients.size, gainsDB.data(), key.sampleRate) <= key.responseTolerance)
+        {
+            const int leadingZeros = maxCentre - (numTaps - 1) / 2 + trimmed;
+            auto padded = arena.allocateSpan(leadingZeros + coefficients.size);
+            if (padded.data == nullptr)
+                return {};
+            
+            std::fill(padded.begin(), padded.begin() + leadingZeros, 0.0f);
+            std::copy(coefficients.begin(), coefficients.end(), padded.begin() + leadingZeros);
+            return padded;
+        }
+        
+        arena.rewind(mark);
+    }
+}
+
+DesignSpan LoudnessCompensatorDSP::designWarpedFilter(const FilterDesignKey& key, DesignArena& arena) const
+{
+    // 31점 ISO gain에서 바로 설계 (warped 축에서 저역이 넓게 펼쳐지므로 수십 탭으로 Ultra 수준의 저역 해상도)
+    // 켑스트럼 작업 버퍼와 FFT도 arena에서 (결과 뒤의 작업 버퍼는 설계가 끝나면 되돌림)
+    const auto gainsDB = calculateISOGains(key.targetPhon, key.referencePhon);
+    auto designed = arena.allocateSpan(key.filterTaps);
+    const auto mark = arena.getMark();
+    auto* workspace = arena.allocate<std::complex<float>>(2 * WarpedFIRFilter::designFFTSize);
+    
+    if (designed.data == nullptr || workspace == nullptr)
+        return {};
+    
+    WarpedFIRFilter::design(ISO226::FREQUENCIES, gainsDB.data(), static_cast<int>(gainsDB.size()),
+                            key.filterTaps, key.sampleRate, WarpedFIRFilter::getWarpingFactor(key.sampleRate),
+                            arena.getFFT(WarpedFIRFilter::designFFTOrder), workspace, designed.data);
+    arena.rewind(mark);
+    return designed;
+}
+
+DesignSpan LoudnessCompensatorDSP::designHybridFilter(const FilterDesignKey& key, float* iirSections, DesignArena& arena)
+{
+    // 긴 FIR이 필요한 저역 기울기는 shelf 단이 맡고, FIR은 남은 곡선(고역, shelf 맞춤 오차)만 설계하므로 짧아도 됨
+    auto gainsDB = calculateISOGains(key.targetPhon, key.referencePhon);
+    BiquadCascade::fitLowShelves(ISO226::FREQUENCIES, gainsDB.data(), static_cast<int>(gainsDB.size()),
+                                 key.sampleRate, hybridCrossoverHz, iirSections);
+    
+    // 남은 곡선 (DC/나이퀴스트는 양 끝 ISO 점 값으로: firwin2는 범위 밖을 마지막 값으로 채우므로
+    // 짧은 FIR에서는 DC 쪽 고역 gain이 저역까지 번짐)
+    const float nyquist = static_cast<float>(key.sampleRate) / 2.0f;
+    std::array<float, numISOFrequencies + 2> normalizedFreq, gainsLinear;
+    int numPoints = 0;
+    
+    for (size_t i = 0; i < gainsDB.size(); ++i)
+    {
+        const float residualDB = gainsDB[i] - BiquadCascade::getMagnitudeDB(iirSections, BiquadCascade::numLowShelves,
+                                                                            ISO226::FREQUENCIES[i], key.sampleRate);
+        
+        if (i == 0)
+        {
+            normalizedFreq[0] = 0.0f;
+            gainsLinear[0] = juce::Decibels::decibelsToGain(residualDB);
+            numPoints = 1;
+        }
+        
+        if (ISO226::FREQUENCIES[i] < nyquist)
+        {
+            normalizedFreq[static_cast<size_t>(numPoints)] = ISO226::FREQUENCIES[i] / nyquist;
+            gainsLinear[static_cast<size_t>(numPoints)] = juce::Decibels::decibelsToGain(residualDB);
+            ++numPoints;
+        }
+    }
+    
+    normalizedFreq[static_cast<size_t>(numPoints)] = 1.0f;
+    gainsLinear[static_cast<size_t>(numPoints)] = gainsLinear[static_cast<size_t>(numPoints - 1)];
+    ++numPoints;
+    
+    return firwin2(key.filterTaps, normalizedFreq.data(), gainsLinear.data(), numPoints,
+                   static_cast<float>(key.sampleRate), arena);
+}
+
+void LoudnessCompensatorDSP::updateSpectralGains()
+{
+    // 설계 없이 ISO gain 곡선을 bin gain으로 바로 옮김 (파라미터 변경 비용은 gain 배열 계산뿐)
+    // 엔진/프레임/지연이 바뀔 때만 STFT를 다시 구성하고 입력 이력으로 상태를 채움
+    const int latencyPadding = params.getLatencyPadding();
+    const bool reconfigure = !spectralActive || spectralFilter.getFrameSize() != params.spectralFrameSize
+                          || spectralFilter.getHopSize() != params.spectralHopSize || spectralFilter.getDelay() != latencyPadding;
+    
+    // 들리는 경로를 바꾸면 페이드아웃이 끝난 뒤 그때의 파라미터로 다시 구성
+    if (reconfigure && deferPathSwitch())
+    {
+        pendingSwitchIR = nullptr;
+        pendingSpectralSwitch = true;
+        return;
+    }
+    
+    if (!reconfigure)
+        cancelPathSwitch();
+    
+    if (reconfigure)
+    {
+        spectralFilter.setFrameSize(params.spectralFrameSize, params.spectralHopSize);
+        spectralFilter.setDelay(latencyPadding);
+    }
+    
+    const auto gainsDB = calculateISOGains(targetPhon, referencePhon);
+    spectralFilter.setGainCurve(ISO226::FREQUENCIES, gainsDB.data(), static_cast<int>(gainsDB.size()),
+                                reconfigure ? 0 : filterRampBlocks * convolver.getPartitionSize());
+    preampGain = -calculateRMSOffset(targetPhon, referencePhon);
+    
+    if (reconfigure)
+    {
+        // currentIR은 그대로 두어 컨볼버가 가리키는 스펙트럼을 유지 (다른 엔진으로 돌아가면 교체됨)
+        spectralActive = true;
+        loadedFilterTaps = 0;
+        loadedLatency = -1;
+        sharedIRBytes.store(0);
+        startPriming();
+    }
+    
+    // 저장소에 없는 키이므로 세션에는 계수가 저장되지 않음
+    appliedDesignKeys.getWriteBuffer() = makeDesignKey();
+    appliedDesignKeys.publish();
+}
+
+float LoudnessCompensatorDSP::measureResponseError(const float* coefficients, int numCoefficients,
+                                                   const float* gainsDB, double sampleRate) const
+{
+    // 홀수 길이 대칭(선형 위상) 필터의 진폭 응답 A(w) = h[c] + 2 * sum h[c + k] cos(kw)를
+    // ISO 주파수(20 Hz - 20 kHz, 나이퀴스트 미만)에서 계산해 목표 gain과의 최대 dB 차이를 반환
+    // cos(kw)는 점화식으로 구해 탭마다 삼각함수를 부르지 않음
+    const int centre = numCoefficients / 2;
+    float maxError = 0.0f;
+    
+    for (int i = 0; i < ISO226::NUM_FREQUENCIES; ++i)
+    {
+        const double frequency = ISO226::FREQUENCIES[i];
+        if (frequency >= sampleRate * 0.5)
+            break;
+        
+        const double cosW = std::cos(2.0 * juce::MathConstants<double>::pi * frequency / sampleRate);
+        double previous = 1.0;
+        double current = cosW;
+        double amplitude = coefficients[centre];
+        
+        for (int k = 1; k <= centre; ++k)
+        {
+            amplitude += 2.0 * coefficients[centre + k] * current;
+            
+            const double next = 2.0 * cosW * current - previous;
+            previous = current;
+            current = next;
+        }
+        
+        const float responseDB = juce::Decibels::gainToDecibels(static_cast<float>(std::abs(amplitude)), -200.0f);
+        maxError = juce::jmax(maxError, std::abs(responseDB - gainsDB[i]));
+    }
+    
+    return maxError;
 }
 
-std::vector<float> LoudnessCompensatorDSP::calculateISOGains(float targetPhon, float referencePhon)
+LoudnessCompensatorDSP::ISOGains LoudnessCompensatorDSP::calculateISOGains(float targetPhon, float referencePhon) const
 {
-    std::vector<float> gains;
+    static_assert(numISOFrequencies == ISO226::NUM_FREQUENCIES, "ISO226 데이터와 크기가 같아야 함");
+    ISOGains gains;
     
-    for (float freq : ISO226::FREQUENCIES)
+    for (int i = 0; i < ISO226::NUM_FREQUENCIES; ++i)
     {
-        float targetSPL = interpolateISO(targetPhon, freq);
-        float referenceSPL = interpolateISO(referencePhon, freq);
+        float targetSPL = interpolateISO(targetPhon, ISO226::FREQUENCIES[i]);
+        float referenceSPL = interpolateISO(referencePhon, ISO226::FREQUENCIES[i]);
         
         // 핵심: reference - target (NOT target - reference!)
         float gainDB = referenceSPL - targetSPL;
-        gains.push_back(gainDB);
+        gains[static_cast<size_t>(i)] = gainDB;
     }
     
     // 1kHz 정규화
@@ -222,95 +2126,144 @@ std::vector<float> LoudnessCompensatorDSP::calculateISOGains(float targetPhon, f
     return gains;
 }
 
-std::vector<float> LoudnessCompensatorDSP::firwin2(int numtaps,
-                                                  const std::vector<float>& freq,
-                                                  const std::vector<float>& gain,
-                                                  float fs)
+DesignSpan LoudnessCompensatorDSP::firwin2(int numtaps,
+                                          const float* freq,
+                                          const float* gain,
+                                          int numPoints,
+                                          float fs,
+                                          DesignArena& arena)
 {
     // Python scipy.signal.firwin2의 정확한 포팅
     float nyq = fs / 2.0f;
     
     // nfreqs 계산: 1 + 2^ceil(log2(numtaps))
     int nfreqs = 1 + (1 << static_cast<int>(std::ceil(std::log2(numtaps))));
+    const int n = (nfreqs - 1) * 2;
     
-    // x = linspace(0.0, nyq, nfreqs)
-    std::vector<float> x(nfreqs);
-    for (int i = 0; i < nfreqs; ++i)
-    {
-        x[i] = nyq * static_cast<float>(i) / static_cast<float>(nfreqs - 1);
-    }
+    // 설계 scratch는 arena의 IRFFT 작업 버퍼 하나 (앞쪽 numtaps개가 그대로 결과 계수)
+    // (x, freq_hz, fx, fx2는 별도 배열 없이 바로 스펙트럼에 기록)
+    auto* workspace = arena.allocate<float>(n * 2);
+    if (workspace == nullptr)
+        return {};
     
-    // freq/gain을 실제 주파수로 변환 (정규화된 주파수를 Hz로)
-    std::vector<float> freq_hz;
-    for (float f : freq)
-    {
-        freq_hz.push_back(f * nyq);
-    }
+    std::fill(workspace, workspace + n * 2, 0.0f);
+    auto* spectrum = reinterpret_cast<std::complex<float>*>(workspace);
     
-    // fx = interp(x, freq_hz, gain)
-    std::vector<float> fx(nfreqs);
-    for (int i = 0; i < nfreqs; ++i)
+    // Extreme 길이(표준 최대 탭 초과)는 작업 스레드에서만 설계: bin/탭 구간과 IRFFT를 공유 작업 스레드에
+    // 나눠 double 정밀도로 계산 (오디오 스레드는 표준 길이까지만 설계하므로 기다리지 않음)
+    // 표준 길이는 한 구간으로 호출한 스레드에서 그대로 계산하므로 계수가 이전과 같음
+    const bool extreme = n >= parallelDesignMinFFTSize;
+    const int chunkSize = extreme ? parallelDesignChunkSize : juce::jmax(nfreqs, numtaps);
+    
+    // 표준 길이는 람다를 바로 불러 std::function 생성(힙 할당)도 피함
+    auto fillSpectrum = [&](int begin, int end)
     {
-        float target_freq = x[i];
-        
-        // Find interpolation points
-        size_t j = 0;
-        for (j = 0; j < freq_hz.size() - 1; ++j)
+        for (int i = begin; i < end; ++i)
         {
-            if (target_freq >= freq_hz[j] && target_freq <= freq_hz[j + 1])
+            // x = linspace(0.0, nyq, nfreqs)
+            float target_freq = nyq * static_cast<float>(i) / static_cast<float>(nfreqs - 1);
+            
+            // fx = interp(x, freq * nyq, gain)
+            size_t j = 0;
+            for (j = 0; j < static_cast<size_t>(numPoints - 1); ++j)
             {
-                break;
+                if (target_freq >= freq[j] * nyq && target_freq <= freq[j + 1] * nyq)
+                {
+                    break;
+                }
             }
+            
+            float fx;
+            if (j >= static_cast<size_t>(numPoints - 1))
+            {
+                // 범위 밖: 마지막 값 사용
+                fx = gain[numPoints - 1];
+            }
+            else
+            {
+                // 선형 보간
+                float t = (target_freq - freq[j] * nyq) / (freq[j + 1] * nyq - freq[j] * nyq);
+                fx = gain[j] * (1.0f - t) + gain[j + 1] * t;
+            }
+            
+            // shift = exp(-(numtaps - 1) / 2. * 1j * pi * x / nyq)
+            std::complex<float> shift;
+            
+            if (extreme)
+            {
+                // Extreme 길이는 위상이 수만 rad이라 float로 계산하면 선형 위상이 흐트러짐
+                // 한 주기가 (numtaps - 1) * i = 4 * (nfreqs - 1)이므로 나머지로 줄여서 double로 계산
+                const auto period = static_cast<juce::int64>(4 * (nfreqs - 1));
+                const double phase = -juce::MathConstants<double>::pi
+                                     * static_cast<double>((static_cast<juce::int64>(numtaps - 1) * i) % period) / (2.0 * (nfreqs - 1));
+                shift = std::complex<float>(static_cast<float>(std::cos(phase)), static_cast<float>(std::sin(phase)));
+            }
+            else
+            {
+                float phase = -(numtaps - 1) / 2.0f * juce::MathConstants<float>::pi * target_freq / nyq;
+                shift = std::complex<float>(std::cos(phase), std::sin(phase));
+            }
+            
+            spectrum[i] = fx * shift;
         }
-        
-        if (j >= freq_hz.size() - 1)
-        {
-            // 범위 밖: 마지막 값 사용
-            fx[i] = gain.back();
-        }
-        else
-        {
-            // 선형 보간
-            float t = (target_freq - freq_hz[j]) / (freq_hz[j + 1] - freq_hz[j]);
-            fx[i] = gain[j] * (1.0f - t) + gain[j + 1] * t;
-        }
-    }
-    
-    // shift = exp(-(numtaps - 1) / 2. * 1j * pi * x / nyq)
-    std::vector<std::complex<float>> fx2(nfreqs);
-    for (int i = 0; i < nfreqs; ++i)
-    {
-        float phase = -(numtaps - 1) / 2.0f * juce::MathConstants<float>::pi * x[i] / nyq;
-        std::complex<float> shift(std::cos(phase), std::sin(phase));
-        fx2[i] = fx[i] * shift;
-    }
+    };
     
-    // IRFFT로 임펄스 응답 생성
-    std::vector<float> out_full = irfft(fx2);
+    if (extreme)
+        workerPool->parallelFor(nfreqs, chunkSize, fillSpectrum);
+    else
+        fillSpectrum(0, nfreqs);
     
-    // 첫 numtaps 샘플만 유지
-    std::vector<float> out(numtaps);
-    for (int i = 0; i < numtaps; ++i)
-    {
-        out[i] = out_full[i];
-    }
+    // IRFFT로 임펄스 응답 생성 (제자리)
+    irfft(workspace, n, arena);
     
-    // Window 적용 (Hann)
-    for (int i = 0; i < numtaps; ++i)
-    {
-        float window = 0.5f - 0.5f * std::cos(2.0f * juce::MathConstants<float>::pi * i / (numtaps - 1));
-        out[i] *= window;
-    }
+    // 첫 numtaps 샘플만 유지 (복사 없이 작업 버퍼 앞쪽을 그대로 씀)
+    DesignSpan out { workspace, numtaps };
     
-    // 1kHz 정규화 (Python과 동일)
+    // Window 적용 (Hann) + 1kHz 응답 (Python과 동일)
+    // 구간별 부분합을 구간 순서대로 더하므로 작업자 수와 무관하게 결과가 같음 (표준 길이는 구간 하나)
     float omega = 2.0f * juce::MathConstants<float>::pi * 1000.0f / fs;
-    std::complex<float> h(0.0f, 0.0f);
+    const int numChunks = (numtaps + chunkSize - 1) / chunkSize;
+    auto* partialSums = arena.allocate<std::complex<double>>(numChunks);
+    if (partialSums == nullptr)
+        return {};
     
-    for (int n = 0; n < numtaps; ++n)
+    auto windowChunk = [&](int begin, int end)
     {
-        float angle = -omega * n;
-        h += out[n] * std::complex<float>(std::cos(angle), std::sin(angle));
-    }
+        std::complex<float> h(0.0f, 0.0f);
+        std::complex<double> extremeSum(0.0, 0.0);
+        
+        for (int k = begin; k < end; ++k)
+        {
+            float window = 0.5f - 0.5f * std::cos(2.0f * juce::MathConstants<float>::pi * k / (numtaps - 1));
+            out[k] *= window;
+            
+            if (extreme)
+            {
+                // Extreme 길이는 각도가 수천 rad까지 커져 float 오차가 크므로 double
+                const double angle = -2.0 * juce::MathConstants<double>::pi * 1000.0 / fs * k;
+                extremeSum += static_cast<double>(out[k]) * std::complex<double>(std::cos(angle), std::sin(angle));
+            }
+            else
+            {
+                float angle = -omega * k;
+                h += out[k] * std::complex<float>(std::cos(angle), std::sin(angle));
+            }
+        }
+        
+        partialSums[begin / chunkSize] = extreme ? extremeSum : std::complex<double>(h);
+    };
+    
+    if (extreme)
+        workerPool->parallelFor(numtaps, chunkSize, windowChunk);
+    else
+        for (int begin = 0; begin < numtaps; begin += chunkSize)
+            windowChunk(begin, juce::jmin(numtaps, begin + chunkSize));
+    
+    std::complex<double> sum(0.0, 0.0);
+    for (int i = 0; i < numChunks; ++i)
+        sum += partialSums[i];
+    
+    const std::complex<float> h(sum);
     
     float magnitude = std::abs(h);
     if (magnitude > 0.0f)
@@ -324,54 +2277,53 @@ std::vector<float> LoudnessCompensatorDSP::firwin2(int numtaps,
     return out;
 }
 
-std::vector<float> LoudnessCompensatorDSP::irfft(const std::vector<std::complex<float>>& spectrum)
+void LoudnessCompensatorDSP::irfft(float* data, int n, DesignArena& arena)
 {
-    // Python scipy.fft.irfft와 동일한 구현
-    // output size = 2 * (input_size - 1)
-    const int n = static_cast<int>((spectrum.size() - 1) * 2);
-    std::vector<float> result(n);
-    
-    // 전체 스펙트럼 구성 (Hermitian symmetry)
-    std::vector<std::complex<float>> fullSpectrum(n);
+    // Python scipy.fft.irfft와 동일한 결과
+    // 입력: data[0 .. n+1] = 양의 주파수 0..n/2 (interleaved complex), 출력: data[0 .. n-1]
+    // 전체 n점 복소 스펙트럼을 따로 만들지 않고 작업 버퍼 안에서 켤레 대칭을 채움
+    auto* spectrum = reinterpret_cast<std::complex<float>*>(data);
+    const int half = n / 2;
     
-    // 양의 주파수 복사
-    for (size_t i = 0; i < spectrum.size(); ++i)
-    {
-        fullSpectrum[i] = spectrum[i];
-    }
+    // DC/Nyquist의 허수부는 실수 출력에 기여하지 않음
+    spectrum[0].imag(0.0f);
+    spectrum[half].imag(0.0f);
     
     // 음의 주파수 (켤레 대칭)
-    for (size_t i = 1; i < spectrum.size() - 1; ++i)
+    for (int i = 1; i < half; ++i)
     {
-        fullSpectrum[n - i] = std::conj(spectrum[i]);
+        spectrum[n - i] = std::conj(spectrum[i]);
     }
     
-    // IFFT 계산
-    for (int k = 0; k < n; ++k)
+    const int order = static_cast<int>(std::log2(n));
+    
+    // Extreme 길이는 복소 역FFT 후 실수부만 앞으로 모음
+    // (i번째 실수부는 float 위치 2i에 있으므로 앞에서부터 옮기면 덮어쓰기 전에 읽음)
+    if (n >= parallelDesignMinFFTSize)
     {
-        std::complex<float> sum(0.0f, 0.0f);
-        for (int j = 0; j < n; ++j)
-        {
-            float angle = 2.0f * juce::MathConstants<float>::pi * j * k / n;
-            std::complex<float> w(std::cos(angle), std::sin(angle));
-            sum += fullSpectrum[j] * w;
-        }
-        result[k] = sum.real() / n;  // 실수부만 취하고 정규화
+        // 작업 스레드의 설계만 이 길이에 옴: 공유 작업 스레드에 나눠 계산
+        workerPool->performInverseFFT(spectrum, order);
+        
+        for (int i = 0; i < n; ++i)
+            data[i] = spectrum[i].real();
+        
+        return;
     }
     
-    return result;
+    // 실수 IFFT (1/n 정규화 포함, FFT 객체는 arena가 미리 만들어 둔 것)
+    arena.getFFT(order).performRealOnlyInverseTransform(data);
 }
 
-float LoudnessCompensatorDSP::calculateRMSOffset(float targetPhon, float referencePhon)
+float LoudnessCompensatorDSP::calculateRMSOffset(float targetPhon, float referencePhon) const
 {
     // Pink noise RMS offset 계산
     // JavaScript 구현과 동일한 로직
     
     // Pink noise의 주파수별 가중치 (1/f)
-    std::vector<float> pinkWeights;
-    for (float freq : isoFrequencies)
+    std::array<float, ISO226::NUM_FREQUENCIES> pinkWeights;
+    for (int i = 0; i < ISO226::NUM_FREQUENCIES; ++i)
     {
-        pinkWeights.push_back(1.0f / std::sqrt(freq));
+        pinkWeights[i] = 1.0f / std::sqrt(ISO226::FREQUENCIES[i]);
     }
     
     // 가중치 정규화
@@ -387,10 +2339,10 @@ float LoudnessCompensatorDSP::calculateRMSOffset(float targetPhon, float referen
     
     // 각 주파수에서의 gain 계산
     float totalSquaredGain = 0.0f;
-    for (size_t i = 0; i < isoFrequencies.size(); ++i)
+    for (int i = 0; i < ISO226::NUM_FREQUENCIES; ++i)
     {
-        float targetSPL = interpolateISO(targetPhon, isoFrequencies[i]);
-        float referenceSPL = interpolateISO(referencePhon, isoFrequencies[i]);
+        float targetSPL = interpolateISO(targetPhon, ISO226::FREQUENCIES[i]);
+        float referenceSPL = interpolateISO(referencePhon, ISO226::FREQUENCIES[i]);
         float gainDB = referenceSPL - targetSPL;
         float gainLinear = std::pow(10.0f, gainDB / 20.0f);
         
@@ -405,138 +2357,66 @@ float LoudnessCompensatorDSP::calculateRMSOffset(float targetPhon, float referen
     return rmsDB;
 }
 
-void LoudnessCompensatorDSP::loadISOData()
-{
-    // ISO 226:2003 데이터 로드
-    // AudioUnit 코드에서 가져옴
-    
-    // 10 phon curve
-    isoCurves[10.0f] = {
-        31.0f, 27.4f, 24.2f, 21.4f, 19.2f, 17.1f, 15.3f, 13.7f, 12.2f, 10.8f,
-        9.6f, 8.5f, 7.5f, 6.5f, 5.6f, 4.9f, 4.2f, 3.7f, 3.4f, 3.3f,
-        3.7f, 4.9f, 7.1f, 9.7f, 12.0f, 13.8f, 14.8f, 14.4f, 13.2f, 11.1f, 8.1f
-    };
-    
-    // 20 phon curve
-    isoCurves[20.0f] = {
-        42.4f, 38.2f, 34.7f, 31.5f, 28.9f, 26.3f, 23.9f, 21.7f, 19.8f, 17.8f,
-        16.0f, 14.4f, 12.9f, 11.4f, 10.2f, 9.2f, 8.3f, 7.6f, 7.0f, 6.8f,
-        7.0f, 8.0f, 10.2f, 13.2f, 16.3f, 19.2f, 21.7f, 23.1f, 23.6f, 22.9f, 20.7f
-    };
-    
-    // 30 phon curve
-    isoCurves[30.0f] = {
-        52.1f, 47.9f, 44.3f, 40.8f, 37.9f, 35.0f, 32.3f, 29.8f, 27.4f, 25.0f,
-        22.8f, 20.8f, 19.0f, 17.1f, 15.5f, 14.1f, 12.9f, 12.0f, 11.4f, 11.1f,
-        11.3f, 12.3f, 14.6f, 17.8f, 21.3f, 25.0f, 28.5f, 31.2f, 33.0f, 33.8f, 32.5f
-    };
-    
-    // 40 phon curve
-    isoCurves[40.0f] = {
-        61.8f, 57.6f, 53.7f, 49.9f, 46.7f, 43.5f, 40.5f, 37.6f, 34.9f, 32.1f,
-        29.6f, 27.2f, 25.0f, 22.8f, 20.8f, 19.0f, 17.5f, 16.3f, 15.6f, 15.2f,
-        15.4f, 16.5f, 18.9f, 22.3f, 26.2f, 30.5f, 34.8f, 38.5f, 41.3f, 43.0f, 42.7f
-    };
-    
-    // 50 phon curve
-    isoCurves[50.0f] = {
-        71.5f, 67.3f, 63.3f, 59.3f, 55.9f, 52.5f, 49.2f, 46.0f, 42.9f, 39.8f,
-        36.8f, 34.0f, 31.4f, 28.7f, 26.3f, 24.1f, 22.3f, 20.8f, 19.9f, 19.4f,
-        19.6f, 20.8f, 23.5f, 27.3f, 31.8f, 36.9f, 42.3f, 47.2f, 51.2f, 53.8f, 54.4f
-    };
-    
-    // 60 phon curve
-    isoCurves[60.0f] = {
-        81.2f, 77.0f, 73.0f, 68.9f, 65.4f, 61.8f, 58.2f, 54.7f, 51.2f, 47.6f,
-        44.2f, 40.9f, 37.8f, 34.6f, 31.8f, 29.2f, 27.0f, 25.3f, 24.1f, 23.5f,
-        23.6f, 24.9f, 27.7f, 31.9f, 37.0f, 43.0f, 49.6f, 55.9f, 61.3f, 65.2f, 66.8f
-    };
-    
-    // 70 phon curve
-    isoCurves[70.0f] = {
-        90.9f, 86.8f, 82.7f, 78.5f, 74.9f, 71.2f, 67.5f, 63.8f, 60.0f, 56.1f,
-        52.3f, 48.7f, 45.1f, 41.5f, 38.2f, 35.2f, 32.6f, 30.5f, 29.0f, 28.2f,
-        28.2f, 29.5f, 32.5f, 37.1f, 42.9f, 49.9f, 57.8f, 65.7f, 72.7f, 78.1f, 80.8f
-    };
-    
-    // 80 phon curve
-    isoCurves[80.0f] = {
-        100.7f, 96.5f, 92.5f, 88.2f, 84.5f, 80.7f, 76.8f, 72.9f, 68.9f, 64.7f,
-        60.5f, 56.5f, 52.5f, 48.5f, 44.8f, 41.3f, 38.3f, 35.8f, 34.0f, 33.0f,
-        32.8f, 34.2f, 37.3f, 42.3f, 48.7f, 56.8f, 66.1f, 75.8f, 84.6f, 91.4f, 95.1f
-    };
-    
-    // 90 phon curve
-    isoCurves[90.0f] = {
-        110.4f, 106.3f, 102.3f, 97.9f, 94.1f, 90.2f, 86.3f, 82.2f, 78.0f, 73.5f,
-        68.9f, 64.5f, 60.1f, 55.6f, 51.4f, 47.5f, 44.1f, 41.2f, 39.0f, 37.8f,
-        37.5f, 38.8f, 42.1f, 47.5f, 54.6f, 63.8f, 74.8f, 86.5f, 97.3f, 105.5f, 110.0f
-    };
-    
-    // 주파수 배열 초기화
-    isoFrequencies.assign(std::begin(ISO226::FREQUENCIES), std::end(ISO226::FREQUENCIES));
-}
-
-void LoudnessCompensatorDSP::calculateAdaptiveParameters()
+void LoudnessCompensatorDSP::calculateAdaptiveParameters(float targetPhon, float& k, float& delta) const
 {
     // targetPhon 레벨에 따라 k와 deltaMax를 자동 조정
     if (targetPhon < 30.0f)
     {
-        kValue = 20.0f;
-        deltaMax = 25.0f;
+        k = 20.0f;
+        delta = 25.0f;
     }
     else if (targetPhon < 40.0f)
     {
-        kValue = 19.0f;
-        deltaMax = 22.0f;
+        k = 19.0f;
+        delta = 22.0f;
     }
     else if (targetPhon < 55.0f)
     {
-        kValue = 18.0f;
-        deltaMax = 20.0f;
+        k = 18.0f;
+        delta = 20.0f;
     }
     else if (targetPhon < 60.0f)
     {
-        kValue = 18.0f;
-        deltaMax = 16.0f;
+        k = 18.0f;
+        delta = 16.0f;
     }
     else if (targetPhon < 70.0f)
     {
-        kValue = 16.0f;
-        deltaMax = 12.0f;
+        k = 16.0f;
+        delta = 12.0f;
     }
     else if (targetPhon < 80.0f)
     {
-        kValue = 14.0f;
-        deltaMax = 8.0f;
+        k = 14.0f;
+        delta = 8.0f;
     }
     else
     {
-        kValue = 12.0f;
-        deltaMax = 4.0f;
+        k = 12.0f;
+        delta = 4.0f;
     }
 }
 
 float LoudnessCompensatorDSP::getMasterGain() const
 {
     // 기본 -3dB
-    float masterGain = -0.0f;
+    float gainDB = -0.0f;
     
     // Preamp gain 추가
-    masterGain += preampGain;
+    gainDB += preampGain;
     
     // Expert Mode가 아닐 때만 헤드룸 보호 적용
-    if (!expertMode && targetPhon > 70.0f)
+    if (!params.expertMode && targetPhon > 70.0f)
     {
         float headroomReduction = -2.0f * (targetPhon - 70.0f) / 20.0f;
         headroomReduction = juce::jmax(-4.0f, headroomReduction);
-        masterGain += headroomReduction;
+        gainDB += headroomReduction;
     }
     
-    return masterGain;
+    return gainDB;
 }
 
-float LoudnessCompensatorDSP::interpolateISO(float phon, float frequency)
+float LoudnessCompensatorDSP::interpolateISO(float phon, float frequency) const
 {
     // ISO 226:2003 기반 정확한 보간
     // AudioUnit 코드와 동일
@@ -553,29 +2433,34 @@ float LoudnessCompensatorDSP::interpolateISO(float phon, float frequency)
         upperPhon = lowerPhon + 10.0f;
     }
     
-    if (isoCurves.find(lowerPhon) == isoCurves.end() ||
-        isoCurves.find(upperPhon) == isoCurves.end())
+    const float* lowerCurve = findISOCurve(lowerPhon);
+    const float* upperCurve = findISOCurve(upperPhon);
+    
+    if (lowerCurve == nullptr || upperCurve == nullptr)
     {
         return phon;  // 기본값
     }
     
+    const float* isoFrequencies = ISO226::FREQUENCIES;
+    const int numFrequencies = ISO226::NUM_FREQUENCIES;
+    
     // 3. 주파수에 대한 선형 보간
     // 주파수가 정확히 일치하는 경우 찾기
-    auto it = std::find(isoFrequencies.begin(), isoFrequencies.end(), frequency);
-    if (it != isoFrequencies.end())
+    auto it = std::find(isoFrequencies, isoFrequencies + numFrequencies, frequency);
+    if (it != isoFrequencies + numFrequencies)
     {
         // 정확한 주파수 - phon 보간만 수행
-        size_t idx = std::distance(isoFrequencies.begin(), it);
+        size_t idx = std::distance(isoFrequencies, it);
         float t = (phon - lowerPhon) / (upperPhon - lowerPhon);
-        float lowerSPL = isoCurves[lowerPhon][idx];
-        float upperSPL = isoCurves[upperPhon][idx];
+        float lowerSPL = lowerCurve[idx];
+        float upperSPL = upperCurve[idx];
         return lowerSPL * (1.0f - t) + upperSPL * t;
     }
     
     // 4. 주파수 보간 필요
     // 인접한 두 주파수 찾기
-    size_t freqIdx = 0;
-    for (size_t i = 0; i < isoFrequencies.size() - 1; ++i)
+    int freqIdx = 0;
+    for (int i = 0; i < numFrequencies - 1; ++i)
     {
         if (frequency >= isoFrequencies[i] && frequency <= isoFrequencies[i + 1])
         {
@@ -585,13 +2470,13 @@ float LoudnessCompensatorDSP::interpolateISO(float phon, float frequency)
     }
     
     // 주파수 범위 밖인 경우
-    if (frequency < isoFrequencies.front())
+    if (frequency < isoFrequencies[0])
     {
         freqIdx = 0;
     }
-    else if (frequency > isoFrequencies.back())
+    else if (frequency > isoFrequencies[numFrequencies - 1])
     {
-        freqIdx = isoFrequencies.size() - 2;
+        freqIdx = numFrequencies - 2;
     }
     
     // 5. 이중 선형 보간 (Bilinear interpolation)
@@ -600,10 +2485,10 @@ float LoudnessCompensatorDSP::interpolateISO(float phon, float frequency)
     float phonRatio = (phon - lowerPhon) / (upperPhon - lowerPhon);
     
     // 4개의 코너 값
-    float spl00 = isoCurves[lowerPhon][freqIdx];
-    float spl01 = isoCurves[lowerPhon][freqIdx + 1];
-    float spl10 = isoCurves[upperPhon][freqIdx];
-    float spl11 = isoCurves[upperPhon][freqIdx + 1];
+    float spl00 = lowerCurve[freqIdx];
+    float spl01 = lowerCurve[freqIdx + 1];
+    float spl10 = upperCurve[freqIdx];
+    float spl11 = upperCurve[freqIdx + 1];
     
     // 주파수 방향 보간
     float spl0 = spl00 * (1.0f - freqRatio) + spl01 * freqRatio;
@@ -11,9 +11,19 @@
 
 #include <juce_core/juce_core.h>
 #include <juce_dsp/juce_dsp.h>
+#include "PartitionedConvolver.h"
+#include "SharedIRStore.h"
+#include "TripleBuffer.h"
+#include "WarpedFIRFilter.h"
+#include "BiquadCascade.h"
+#include "SpectralGainFilter.h"
+#include "SharedWorkerPool.h"
+#include "SharedMemoryIRStore.h"
+#include "DesignArena.h"
 #include <vector>
 #include <complex>
-#include <map>
+#include <atomic>
+#include <array>
 
 class LoudnessCompensatorDSP
 {
@@ -21,67 +31,511 @@ public:
     LoudnessCompensatorDSP();
     ~LoudnessCompensatorDSP();
     
-    // 파라미터 설정
-    void setEasyLoudness(float value); // 0-100
+    static constexpr int maxFilterTaps = 4095;         // 표준 단계 최대 (고정 레이턴시 기준)
+    static constexpr int maxExtremeFilterTaps = 65535; // Extreme 단계 최대 (버퍼는 선택했을 때 할당)
+    static constexpr int warpedFilterTaps = 48;  // warped 엔진 탭 수 (allpass 단 수)
+    static constexpr int hybridFilterTaps = 255; // hybrid 엔진의 FIR 탭 수 (저역은 IIR shelf 단이 맡음)
+    
+    // 설계 알고리즘 버전: 결과 계수가 바뀌는 수정을 하면 올려서 세션에 저장된 계수와 프로세스 간 저장소의 계수를 무효화
+    static constexpr juce::uint32 designVersion = 4;
+    
+    // 필터 엔진 (설계 키에도 들어가므로 SharedIRStore.h에 정의)
+    using FilterEngine = ::FilterEngine;
+    
+    // 사용자 파라미터 묶음: 메시지/호스트 스레드가 통째로 발행하고 오디오 스레드가 블록마다 가져감
+    struct Parameters
+    {
+        float kValue = 20.0f;  // 기본값 20
+        float deltaMax = 20.0f;
+        int filterTaps = 4095;  // Ultra 기본값
+        bool expertMode = false;  // Expert Mode 플래그
+        bool constantLatency = false;  // 모든 품질 단계를 최대 탭 레이턴시로 맞춤
+        bool qualityGovernor = false;  // CPU 부하가 높으면 탭 단계를 자동으로 낮춤 (레이턴시는 그대로)
+        float responseTolerance = 0.25f;  // 목표 곡선 대비 허용 오차 (dB): 이 안에서 가장 짧은 필터 사용
+        FilterEngine engine = FilterEngine::linearPhase;
+        int spectralFrameSize = 1024;  // spectral 엔진의 STFT 프레임 (레이턴시 frameSize - 1)
+        int spectralHopSize = 256;     // 프레임 간격 (frameSize / 2 ~ frameSize / 8)
+        bool bypass = false;
+        
+        bool isWarped() const { return engine == FilterEngine::warped; }
+        
+        // 엔진이 실제로 쓰는 탭 수 (warped/hybrid는 고정, spectral은 프레임 길이)
+        int getEngineFilterTaps() const
+        {
+            if (engine == FilterEngine::warped)
+                return warpedFilterTaps;
+            
+            if (engine == FilterEngine::spectral)
+                return spectralFrameSize;
+            
+            return engine == FilterEngine::hybrid ? hybridFilterTaps : filterTaps;
+        }
+        
+        // 필터 자체의 레이턴시 (warped 엔진은 최소 위상이라 0, spectral은 프레임이 다 찰 때까지)
+        int getEngineLatency() const
+        {
+            if (engine == FilterEngine::spectral)
+                return spectralFrameSize - 1;
+            
+            return isWarped() ? 0 : getEngineFilterTaps() / 2;
+        }
+        
+        // 고정 레이턴시 모드에서는 모든 엔진을 표준 최대 탭 레이턴시로 맞춤 (Extreme 단계는 자기 레이턴시)
+        int getLatencySamples() const
+        {
+            return constantLatency ? juce::jmax(maxFilterTaps / 2, getEngineLatency()) : getEngineLatency();
+        }
+        
+        // 고정 레이턴시: 짧은 IR 앞에 0을 붙여 최대 탭과 같은 레이턴시로 맞춤
+        // (앞쪽 0 파티션은 컨볼버가 건너뛰므로 연산량은 그대로, warped/spectral은 출력 지연)
+        int getLatencyPadding() const
+        {
+            return getLatencySamples() - getEngineLatency();
+        }
+    };
+    
+    // 파라미터 설정 (아래 set 함수들은 어느 스레드에서 불러도 됨, 오디오 스레드는 기다리지 않음)
+    void setParameters(const Parameters& newParameters);
+    Parameters getParameters() const;  // 마지막으로 발행한 값
+    
+    // 오디오 스레드의 쓰기 (잠금 없음): 호스트 자동화처럼 오디오 스레드에서 바뀐 값을 다음 process에 바로 적용
+    // process와 겹치지 않으면(prepare 전) 다른 스레드에서 불러도 됨
+    // 한 인스턴스는 이 경로와 위의 set 함수들 중 하나로만 씀 (getParameters는 이 경로의 값을 보지 않음)
+    void setParametersFromAudioThread(const Parameters& newParameters);
+    
+    // 에디터 표시값(target/reference phon, 레이턴시)만 바로 갱신 (어느 스레드에서든, 원자 변수만 씀)
+    // 오디오 처리가 멈춰 있어도 표시가 파라미터를 따라가도록, 오디오에는 다음 process에서 적용됨
+    void publishDisplayValues(float easyLoudnessValue, const Parameters& parameters);
+    
+    void setEasyLoudness(float value); // 0-100, 오디오 스레드 (블록 내 자동화) 또는 prepare 전
+    float getAppliedLoudness() const { return easyLoudness; }  // 오디오 스레드: 지금 처리에 쓰는 값 (표시값은 getTargetPhon)
+    
+    // 이 Loudness 값의 설계가 이미 저장소에 있으면 true (오디오 스레드, 설계는 하지 않음)
+    // 블록 내 자동화는 준비된 중간값으로만 나눠 전환해서 호스트 블록당 설계를 목표값 한 번으로 제한
+    bool isDesignReady(float easyLoudnessValue) const;
     void setBypass(bool bypass);
     void setKValue(float k);
     void setDeltaMax(float delta);
     void setFilterTaps(int taps);
     void setExpertMode(bool expert);
+    void setFilterRampBlocks(int blocks); // 필터 교체 시 계수 램프 길이 (컨볼루션 블록 단위)
+    void setNonRealtime(bool isNonRealtime); // 오프라인 렌더링 여부 (다음 process에서 전환)
+    void setConstantLatency(bool shouldBeConstant);
+    void setQualityGovernor(bool enabled);
+    void setResponseTolerance(float decibels);  // 0 = 항상 filterTaps 전체 길이
+    void setFilterEngine(FilterEngine newEngine);  // warped/hybrid/spectral은 filterTaps/governor/허용 오차와 무관
+    void setSpectralFrameSize(int frameSize, int hopSize);  // spectral 엔진 STFT 설정 (2의 거듭제곱으로 맞춤)
+    
+    // 점진 설계: 저장소에 없는 설정은 짧은 미리듣기 필터를 같은 레이턴시로 바로 적용하고,
+    // 전체 길이 설계가 끝나면 계수 램프로 넘어감 (기본 켜짐, 오프라인 렌더링은 항상 전체 설계)
+    void setProgressiveDesign(bool shouldBeProgressive);
+    bool isProgressiveDesign() const { return progressiveDesign.load(); }
+    
+    // 파라미터 배치: begin/end 사이의 변경은 끝난 뒤 설계 한 번으로 합쳐짐 (세션 복원 등)
+    void beginParameterBatch();
+    void endParameterBatch();
+    
+    struct ScopedParameterBatch
+    {
+        explicit ScopedParameterBatch(LoudnessCompensatorDSP& d) : dsp(d) { dsp.beginParameterBatch(); }
+        ~ScopedParameterBatch() { dsp.endParameterBatch(); }
+        
+        LoudnessCompensatorDSP& dsp;
+        JUCE_DECLARE_NON_COPYABLE(ScopedParameterBatch)
+    };
+    
+    // 설계 요청/실행 횟수 (요청이 여러 번 쌓여도 실행은 블록당 최대 한 번)
+    juce::int64 getDesignRequestCount() const { return designRequests.load(); }
+    juce::int64 getDesignExecutionCount() const { return designsExecuted.load(); }
+    
+    // Extreme 단계 버퍼: 발행된 파라미터가 할당된 버퍼보다 긴 필터를 쓰면 true (어느 스레드에서든)
+    // 늘리는 것은 메시지 스레드에서 process와 겹치지 않게 (오디오 처리를 멈춘 상태에서) 부르고,
+    // 그때까지 오디오 스레드는 이전 파라미터로 처리함 (오프라인 렌더링은 process에서 바로 늘림)
+    bool needsFilterCapacity() const;
+    void growFilterCapacity();
     
     // 오디오 처리
     void prepare(double sampleRate, int maximumBlockSize);
     void process(juce::AudioBuffer<float>& buffer);
     void reset();
     
-    // 정보 획득
-    float getTargetPhon() const { return targetPhon; }
-    float getReferencePhon() const { return referencePhon; }
+    // 무음 입력이 이어져 컨볼루션 꼬리가 모두 빠졌으면 true (출력은 0, 처리 생략)
+    bool skipIfIdle(const juce::AudioBuffer<float>& buffer);
+    bool isIdle() const { return idle; }
+    juce::int64 getSkippedBlockCount() const { return skippedBlocks.load(); }
+    
+    // 오프라인 2단 컨볼루션 사용 중이면 true
+    bool isOfflineRendering() const { return offlineActive; }
+    
+    // 첫 필터가 적용되었으면 true (그 전까지는 지연된 원신호 통과)
+    bool isFilterReady() const { return filterReady; }
+    
+    // prepare부터 첫 필터 적용까지 걸린 시간 (ms, 아직이면 음수)
+    float getInitialDesignMilliseconds() const { return initialDesignMilliseconds.load(); }
+    
+    // 추측 설계 통계: 오디오 스레드의 재설계가 저장소에서 바로 찾은 횟수(hit)와 직접 설계한 횟수(miss)
+    struct SpeculationStats
+    {
+        juce::int64 speculativeDesigns = 0;
+        juce::int64 hits = 0;
+        juce::int64 misses = 0;
+        
+        double getHitRate() const { return hits + misses > 0 ? static_cast<double>(hits) / static_cast<double>(hits + misses) : 0.0; }
+    };
+    
+    SpeculationStats getSpeculationStats() const
+    {
+        return { speculativeDesigns.load(), designCacheHits.load(), designCacheMisses.load() };
+    }
+    
+    // 프로세스 전역 작업 스레드의 대기열 상태 (모든 인스턴스 합계)
+    SharedWorkerPool::Stats getWorkerPoolStats() const { return workerPool->getStats(); }
+    
+    // 품질 governor: 블록 길이 대비 처리 시간이 높으면 한 단계씩 낮추고 부하가 내려가면 다시 올림
+    // 단계 변경은 오디오 스레드가 lock-free FIFO에 기록하고, 한 스레드(에디터 타이머 등)에서만 읽음
+    struct GovernorEvent
+    {
+        enum class Type { downgrade, upgrade };
+        
+        Type type = Type::downgrade;
+        int fromTaps = 0;
+        int toTaps = 0;
+        float load = 0.0f;             // 전환 시점의 평균 부하 (처리 시간 / 블록 길이)
+        double timeMilliseconds = 0.0; // juce::Time::getMillisecondCounterHiRes 기준
+    };
+    
+    bool readGovernorEvent(GovernorEvent& event);
+    int getGovernorLevel() const { return publishedGovernorLevel.load(); }  // 0 = 선택한 품질 그대로
+    float getProcessLoad() const { return publishedProcessLoad.load(); }
+    
+    // 정보 획득 (에디터 타이머 등 다른 스레드에서 읽어도 안전)
+    float getTargetPhon() const { return publishedTargetPhon.load(); }
+    float getReferencePhon() const { return publishedReferencePhon.load(); }
     float getPreampGain() const { return preampGain; }
-    int getLatencySamples() const { return filterTaps / 2; }
+    int getLatencySamples() const { return publishedLatency.load(); }  // 마지막으로 발행한 파라미터 기준
+    bool isConstantLatency() const { return publishedConstantLatency.load(); }
+    
+    // 현재 phon의 목표 보정 곡선: ISO 226 31개 주파수의 gain (dB, 1 kHz = 0), 엔진 정확도 측정용
+    static constexpr int numISOFrequencies = 31;
+    using ISOGains = std::array<float, numISOFrequencies>;
+    ISOGains getTargetGains() const { return calculateISOGains(getTargetPhon(), getReferencePhon()); }
+    
+    // 인스턴스 메모리 사용량 (바이트)
+    struct MemoryUsage
+    {
+        size_t instance = 0;              // 객체 자체
+        size_t convolutionState = 0;      // FDL, overlap, FFT 작업 버퍼
+        size_t coefficientRamp = 0;       // 계수 램프 버퍼
+        size_t sharedImpulseResponse = 0; // 저장소에서 빌린 IR (인스턴스 간 공유)
+        size_t designArena = 0;           // 설계 scratch arena (오디오 스레드용 + 작업 스레드용, 최대 탭 단계 크기)
+        size_t designScratchPeak = 0;     // 마지막 설계가 arena에서 쓴 크기
+        size_t designSpares = 0;          // 오디오 스레드 설계 결과를 받을 빈 IR (다음 예약 한 번분)
+        
+        // 이 인스턴스만 상주시키는 메모리 (공유 IR 제외)
+        size_t getResidentBytes() const { return instance + convolutionState + coefficientRamp + designArena + designSpares; }
+    };
+    
+    MemoryUsage getMemoryUsage() const;
+    
+    // 세션 저장/복원 (메시지 스레드)
+    // 현재 적용된 IR (없으면 nullptr), 복원한 계수는 키가 맞을 때 설계 대신 사용
+    SharedImpulseResponse::Ptr getCurrentDesign();
+    void restoreDesign(const FilterDesignKey& key, std::vector<float> coefficients, float preampGain,
+                       std::vector<float> iirSections = {});
     
 private:
     // DSP 핵심 함수들 (AudioUnit 코드에서 포팅)
-    void updateFIRCoefficients();
-    std::vector<float> generateFIRFilter(float targetPhon, float referencePhon);
-    std::vector<float> calculateISOGains(float targetPhon, float referencePhon);
-    std::vector<float> firwin2(int numtaps, const std::vector<float>& freq, 
-                              const std::vector<float>& gain, float fs);
-    std::vector<float> irfft(const std::vector<std::complex<float>>& spectrum);
+    bool updateFIRCoefficients(bool mayWait);  // false = 다른 스레드가 설계 중이라 현재 IR 유지
+    FilterDesignKey makeDesignKey() const;
+    SharedImpulseResponse::Ptr findDesign(const FilterDesignKey& key);  // 저장소/복원 계수에서만 찾음
+    SharedImpulseResponse::Ptr findOrDesign(const FilterDesignKey& key, DesignArena& arena);
+    void findOrCreateTail(const SharedImpulseResponse& impulseResponse);
+    SharedImpulseResponse::Ptr tryFindOrDesign(const FilterDesignKey& key, bool& inFlight);  // 오디오 스레드 (기다리지 않음)
+    SharedImpulseResponse::Ptr createImpulseResponse(const FilterDesignKey& key, DesignArena& arena, bool mayWait,
+                                                     SharedImpulseResponse* spare = nullptr);  // spare: 결과를 채울 빈 항목
+    SharedImpulseResponse::Ptr findOrDesignInBackground(const FilterDesignKey& key);  // 작업 스레드용 arena로
+    void applyImpulseResponse(const SharedImpulseResponse::Ptr& impulseResponse);
+    void requestDesign();
+    bool runPendingDesign();
+    void updateDesignParameters();
+    void publishParameters();
+    static Parameters limitParameters(Parameters parameters);
+    void publishReadouts(const Parameters& snapshot);
+    void acquireParameters(int availableFilterTaps);  // 이보다 긴 필터가 필요한 묶음은 적용을 미룸
+    
+    // 설계 함수는 모든 작업 버퍼와 결과를 arena에서 받음 (결과 span은 다음 설계 전까지 유효)
+    DesignSpan generateFIRFilter(float targetPhon, float referencePhon, int numTaps, double sampleRate, DesignArena& arena);
+    DesignSpan designAdaptiveFilter(const FilterDesignKey& key, DesignArena& arena);
+    DesignSpan designWarpedFilter(const FilterDesignKey& key, DesignArena& arena) const;
+    DesignSpan designHybridFilter(const FilterDesignKey& key, float* iirSections, DesignArena& arena);
+    void updateSpectralGains();
+    float measureResponseError(const float* coefficients, int numCoefficients, const float* gainsDB,
+                               double sampleRate) const;
+    ISOGains calculateISOGains(float targetPhon, float referencePhon) const;
+    DesignSpan firwin2(int numtaps, const float* freq, const float* gain, int numPoints, float fs, DesignArena& arena);
+    void irfft(float* data, int n, DesignArena& arena);
+    void reserveDesignArena(DesignArena& arena, int maxTaps, int maxTransformPartitionSize = 0) const;
+    
+    // 오디오 스레드가 설계하는 키: 계수(레이턴시 패딩 포함)가 표준 최대 탭 이하 (미리듣기/표준 단계)
+    static bool isAudioThreadDesign(const FilterDesignKey& key) { return key.latencyPadding + key.filterTaps <= maxFilterTaps; }
+    
+    // 컨볼루션 경로
+    void loadImpulseResponse(const SharedImpulseResponse::Ptr& impulseResponse, bool rampCoefficients);
+    void convolve(juce::dsp::AudioBlock<float>& block);
+    void convolveTwoStage(juce::dsp::AudioBlock<float>& block);
+    bool needsTail(const SharedImpulseResponse& impulseResponse) const;
+    SharedImpulseResponse::Ptr findTail(const SharedImpulseResponse& impulseResponse) const;
+    void requestBackgroundDesign(const FilterDesignKey& key);
+    void switchRenderPath(bool offline);
+    void prepareConvolution(int partitionSize);
+    void allocateTailStage();
+    void resizeFilterCapacity();
+    bool isTwoStage() const { return tailBlockSize > 0 && (offlineActive || realtimeTwoStage); }
+    void pushInputHistory(const juce::AudioBuffer<float>& buffer);
+    void readDelayedInput(juce::AudioBuffer<float>& destination, int numSamples);
+    void startPriming();
+    bool advancePriming(int numSamples);
+    bool deferPathSwitch();
+    void cancelPathSwitch();
+    void applyPendingPathSwitch();
+    void resetConvolution();
+    
+    // 첫 설계 (백그라운드)
+    void launchInitialDesign(const FilterDesignKey& key);
+    void cancelInitialDesign();
+    bool collectInitialDesign();
     
-    // ISO 226:2003 데이터
-    void loadISOData();
-    float interpolateISO(float phon, float frequency);
+    // 점진 설계의 전체 길이 IR (설계 스레드 → 오디오 스레드)
+    void collectRefinedDesign();
+    
+    // ISO 226:2003 데이터 (정적 테이블 보간)
+    float interpolateISO(float phon, float frequency) const;
     
     // RMS 계산
-    float calculateRMSOffset(float targetPhon, float referencePhon);
+    float calculateRMSOffset(float targetPhon, float referencePhon) const;
+    
+    // 품질 governor (오디오 스레드)
+    void updateGovernor(juce::int64 elapsedTicks, int numSamples);
+    void setGovernorLevel(int level);
+    int getEffectiveFilterTaps() const;
+    
+    // 파라미터 발행: 쓰기끼리만 잠금, 오디오 스레드는 트리플 버퍼에서 wait-free로 가져감
+    juce::CriticalSection parameterWriteLock;
+    Parameters pendingParameters;
+    TripleBuffer<Parameters> parameterSnapshots;
+    
+    // 오디오 스레드가 직접 쓴 묶음 (다음 acquireParameters가 트리플 버퍼 대신 가져감)
+    Parameters audioThreadParameters;
+    bool audioThreadParametersPending = false;
     
-    // 파라미터
+    // 마지막으로 발행한 묶음의 값 (어느 스레드에서든 읽음, 두 쓰기 경로 모두 갱신)
+    std::atomic<int> publishedLatency { Parameters().getLatencySamples() };
+    std::atomic<int> publishedEngineFilterTaps { Parameters().getEngineFilterTaps() };
+    std::atomic<bool> publishedConstantLatency { Parameters().constantLatency };
+    
+    // 오디오 스레드가 사용하는 파라미터 (블록 시작 시 갱신)
+    Parameters params;
     float easyLoudness = 55.0f;  // 40-70 범위의 중간값
     float targetPhon = 65.0f;
     float referencePhon = 83.0f;
-    float kValue = 20.0f;  // 기본값 20
-    float deltaMax = 20.0f;
     float preampGain = 0.0f;
-    int filterTaps = 4095;  // Ultra 기본값
-    bool bypass = false;
-    bool expertMode = false;  // Expert Mode 플래그
-    bool coefficientsNeedUpdate = true;
+    std::atomic<float> publishedTargetPhon { 65.0f };
+    std::atomic<float> publishedReferencePhon { 83.0f };
+    
+    int filterRampBlocks = 8;
+    int loadedFilterTaps = 0;  // 컨볼버에 로드된 IR 길이 (0 = 없음)
+    int loadedLatency = -1;    // 컨볼버에 로드된 IR의 레이턴시 (-1 = 없음)
+    
+    // 설계 요청: 변경마다 세대 증가, 오디오 스레드는 실행한 세대와 다를 때만 설계
+    std::atomic<juce::uint32> requestedGeneration { 0 };
+    juce::uint32 executedGeneration = 0;
+    std::atomic<int> batchDepth { 0 };
+    std::atomic<juce::int64> designRequests { 0 };
+    std::atomic<juce::int64> designsExecuted { 0 };
+    
+    // 오디오 스레드가 저장소에 예약하고 직접 설계한 IR (한 번에 하나)
+    // 저장소 등록과 같은 키를 기다리는 스레드 깨우기는 잠금과 이벤트 신호가 필요하므로 폴링 콜백이 맡음
+    struct ClaimedDesign
+    {
+        FilterDesignKey key;
+        SharedImpulseResponse::Ptr impulseResponse;  // 설계 실패 시 nullptr
+        SharedImpulseResponse::Ptr tail;             // Extreme 단계의 뒷단 스펙트럼
+    };
+    
+    // claimEmpty: 예비 항목이 준비됨, claimDesigning: 오디오 스레드가 예비 항목으로 설계 중,
+    // claimReady: 폴링 콜백이 넘길 예약이 있음, claimCompleting: 폴링 콜백이 넘기거나 예비 항목을 새로 만드는 중
+    enum ClaimState { claimEmpty, claimDesigning, claimReady, claimCompleting };
+    
+    void completeClaimedDesign();
+    void prepareClaimSpares();
+    
+    ClaimedDesign claimedDesign;
+    std::atomic<int> claimState { claimEmpty };
+    SharedImpulseResponse::Ptr claimedTail;  // 오디오 스레드 전용: 등록 전에 loadImpulseResponse가 찾을 수 있도록
+    
+    // 오디오 스레드 설계가 채울 예비 항목과 저장소 예약 (폴링 콜백이 현재 용량/파티션 크기로 미리 만들어 둠)
+    SharedImpulseResponse::Ptr spareDesign;
+    SharedImpulseResponse::Ptr spareTail;
+    SharedIRStore::Claim spareClaim;
+    
+    // 첫 설계: 생성/prepare가 설계를 기다리지 않도록 작업 스레드에서 수행
+    // 결과는 참조 하나를 붙인 포인터로 넘기고 오디오 스레드가 교환해서 가져감
+    std::atomic<SharedImpulseResponse*> finishedDesign { nullptr };
+    juce::WaitableEvent initialDesignDone { true };
+    bool filterReady = false;
+    double initialDesignStart = 0.0;
+    std::atomic<float> initialDesignMilliseconds { -1.0f };
+    
+    // 백그라운드 작업: 폴링 콜백이 발행된 요청을 보고 프로세스 전역 작업 스레드에 넣음
+    // 점진 설계의 전체 길이 IR을 먼저 설계하고, 남는 시간에 추측 설계
+    // 추측 설계는 오디오 스레드가 발행한 Loudness 움직임을 보고 다음 값들을 하나씩 미리 설계하며,
+    // CPU 예산(한 코어 기준 비율)만큼만 일하고 나머지는 쉼
+    void pollBackgroundWork();
+    void refineDesign(const FilterDesignKey& key);
+    void rememberSpeculativeDesign(SharedImpulseResponse::Ptr impulseResponse);
+    void trackLoudnessMotion(float delta);
+    
+    struct SpeculationRequest
+    {
+        Parameters parameters;
+        float easyLoudness = 0.0f;
+        float step = 0.0f;  // 예측 한 단계당 Loudness 변화 (부호 = 움직이는 방향)
+        FilterDesignKey key;  // 현재 설정의 설계 키 (governor 단계, 엔진 반영), phon만 바꿔서 설계
+    };
+    
+    static constexpr int speculationDepth = 4;         // 움직이는 방향으로 미리 설계할 값 수
+    static constexpr int speculationCacheSize = 8;
+    static constexpr double speculationCpuBudget = 0.25;
+    
+    std::atomic<bool> backgroundWorkStarted { false };
+    TripleBuffer<SpeculationRequest> speculationRequests;
+    SpeculationRequest speculation;                    // 폴링 콜백에서만 사용
+    int speculationStep = speculationDepth + 1;
+    float previousSpeculativeLoudness = 0.0f;
+    std::atomic<bool> speculationRunning { false };
+    std::atomic<double> speculationResumeTime { 0.0 };  // 예산을 넘지 않도록 다음 추측 설계를 미룸
+    std::array<SharedImpulseResponse::Ptr, speculationCacheSize> speculationCache;  // 추측 작업에서만 사용 (한 번에 하나)
+    int nextSpeculationCacheSlot = 0;
+    float loudnessStep = 0.0f;
+    std::atomic<juce::int64> speculativeDesigns { 0 };
+    std::atomic<juce::int64> designCacheHits { 0 };
+    std::atomic<juce::int64> designCacheMisses { 0 };
+    
+    // 점진 설계: 오디오 스레드가 전체 길이 키를 발행하고, 결과는 참조 하나를 붙인 포인터로 돌려받음
+    static constexpr int previewFilterTaps = 511;
+    std::atomic<bool> progressiveDesign { true };
+    TripleBuffer<FilterDesignKey> refinementRequests;
+    std::atomic<SharedImpulseResponse*> refinedDesign { nullptr };
+    std::atomic<bool> refinementRunning { false };
+    
+    // 품질 governor: 단계마다 탭 수를 절반으로 (최소 minGovernedFilterTaps), 모자란 레이턴시는 앞쪽 0으로 맞춤
+    static constexpr int minGovernedFilterTaps = 511;
+    static constexpr float governorDowngradeLoad = 0.5f;  // 블록 길이의 절반 이상을 쓰면 한 단계 내림
+    static constexpr float governorUpgradeLoad = 0.2f;    // 올리면 연산량이 약 두 배이므로 충분히 낮을 때만
+    static constexpr double governorAverageSeconds = 0.25;
+    static constexpr double governorHoldSeconds = 1.0;    // 전환 후 평균이 다시 안정될 때까지 대기
+    static constexpr int governorEventCapacity = 32;
+    
+    int governorLevel = 0;
+    float processLoad = 0.0f;
+    int governorHoldSamples = 0;
+    std::atomic<int> publishedGovernorLevel { 0 };
+    std::atomic<float> publishedProcessLoad { 0.0f };
+    juce::AbstractFifo governorEventFifo { governorEventCapacity };
+    std::array<GovernorEvent, governorEventCapacity> governorEvents;
+    
+    // 세션 저장용: 오디오 스레드가 적용한 IR의 키를 발행
+    TripleBuffer<FilterDesignKey> appliedDesignKeys;
+    juce::CriticalSection designKeyReadLock;
+    bool hasAppliedDesign = false;
+    SharedImpulseResponse::Ptr restoredDesign;
+    
+    // 무음/유휴 상태
+    int silentSamples = 0;
+    bool idle = false;
+    std::atomic<juce::int64> skippedBlocks { 0 };
+    
+    // 메모리 보고용 (에디터 스레드에서 읽음)
+    std::atomic<size_t> sharedIRBytes { 0 };
+    std::atomic<size_t> lastDesignScratchBytes { 0 };
+    std::atomic<size_t> designSpareBytes { 0 };
+    
+    // 설계 scratch: 오디오 스레드의 재설계와 작업 스레드의 설계가 겹칠 수 있으므로 따로 둠
+    // 작업 스레드 쪽은 같은 인스턴스의 작업끼리(첫 설계/점진/추측) 잠금으로 차례로 씀
+    // 오디오 스레드 쪽은 표준 최대 탭까지만 상주 (Extreme 단계는 작업 스레드 쪽이 쓸 때 키움)
+    DesignArena audioDesignArena;
+    DesignArena backgroundDesignArena;
+    juce::CriticalSection backgroundDesignLock;
     
     // 적응형 파라미터 계산
-    void calculateAdaptiveParameters();
+    void calculateAdaptiveParameters(float targetPhon, float& k, float& delta) const;
+    float calculateReferencePhon(float targetPhon, const Parameters& parameters) const;
     float getMasterGain() const;
     
     // 샘플레이트
     double currentSampleRate = 48000.0;
     
-    // FIR 필터
-    std::vector<float> firCoefficients;
-    juce::dsp::Convolution convolution;
+    // FIR 필터 (프로세스 전역 저장소에서 빌려 씀)
+    juce::SharedResourcePointer<SharedIRStore> irStore;
+    juce::SharedResourcePointer<SharedMemoryIRStore> sharedMemoryStore;  // 다른 프로세스와 계수 공유 (빌드 옵션)
+    juce::SharedResourcePointer<SharedWorkerPool> workerPool;  // 모든 인스턴스의 설계/복원/추측 작업, Extreme 길이 설계 분할
+    std::unique_ptr<SharedWorkerPool::Client> designJobs;      // 이 인스턴스가 넣은 작업 (소멸 시 취소/대기)
+    std::atomic<int> preparedPartitionSize { 0 };              // 세션 복원 시 미리 변환할 파티션 크기 (0 = prepare 전)
+    static constexpr int parallelDesignMinFFTSize = 16384;     // firwin2 IRFFT 길이 (표준 최대 탭은 8192)
+    static constexpr int parallelDesignChunkSize = 4096;       // bin/탭 구간 (작업자 수와 무관하게 고정)
+    SharedImpulseResponse::Ptr currentIR;
+    PartitionedConvolver convolver;
+    juce::SmoothedValue<float> masterGain { 1.0f };
+    
+    // warped 엔진 (현재 IR 키가 warped일 때 convolver 대신 사용)
+    WarpedFIRFilter warpedFilter;
+    
+    // hybrid 엔진의 저역 shelf 단 (현재 IR 키가 hybrid일 때 convolver 앞에 적용)
+    BiquadCascade shelfFilter;
+    
+    // spectral 엔진: IR 없이 bin gain만 갱신 (사용 중에는 currentIR 없음)
+    SpectralGainFilter spectralFilter;
+    bool spectralActive = false;
+    
+    // 오프라인 렌더링과 Extreme 단계: 앞부분은 작은 파티션(convolver), 뒷부분은 큰 블록(tailConvolver)
+    // 뒷부분은 tailBlockSize만큼 모아서 한 번에 처리하고 다음 블록 동안 출력하므로 레이턴시가 늘지 않음
+    bool offlineRequested = false;
+    bool offlineActive = false;
+    static constexpr int maxTwoStagePartitionSize = 64;
+    static constexpr int maxUniformPartitions = 128;  // 실시간에 이보다 파티션이 많아지는 Extreme 길이는 2단
+    int filterCapacity = maxFilterTaps;  // 버퍼를 할당한 최대 탭 수 (Extreme 단계를 고르면 늘어남)
+    std::atomic<int> publishedFilterCapacity { maxFilterTaps };
+    bool parametersHeld = false;         // 버퍼가 모자라 적용을 미룬 묶음이 읽기 버퍼에 있음
+    int preparedBlockSize = 0;
+    int tailBlockSize = 0;  // 0 = 2단 분할 이득 없음 (이미 큰 파티션)
+    bool realtimeTwoStage = false;
+    std::atomic<int> designTailBlockSize { 0 };  // 설계 스레드가 뒷단 스펙트럼을 미리 만들 블록 크기 (2단 경로가 아니면 0)
+    int tailPosition = 0;
+    SharedImpulseResponse::Ptr tailIR;
+    PartitionedConvolver tailConvolver;
+    juce::AudioBuffer<float> tailInput;
+    juce::AudioBuffer<float> tailOutput;
+    
+    // 컨볼버 입력 이력 (경로 전환/바이패스 해제 시 상태 채우기, 바이패스 지연선)
+    juce::AudioBuffer<float> inputHistory;
+    juce::AudioBuffer<float> primeScratch;
+    int historyPosition = 0;
+    
+    // 바이패스: 레이턴시만큼 지연된 원신호와 크로스페이드, 완전 바이패스 중에는 컨볼버 정지
+    static constexpr double bypassFadeSeconds = 0.01;
+    juce::SmoothedValue<float> wetMix { 1.0f };
+    juce::AudioBuffer<float> dryScratch;
+    bool convolutionSuspended = false;
     
-    // ISO 데이터
-    std::map<float, std::vector<float>> isoCurves;
-    std::vector<float> isoFrequencies;
+    // 경로 전환 (바이패스 해제, 엔진/실시간 경로 변경): 들리는 경로는 원신호로 페이드아웃한 뒤 바꾸고,
+    // 새 경로는 입력 이력을 블록마다 나눠 흘려 보내 따라잡을 때까지 원신호를 내보낸 뒤 크로스페이드로 들어감
+    enum class PathState { running, fadingOut, priming };
+    static constexpr int primingBlocksPerBlock = 4;  // 채우는 동안 블록마다 흘려 보내는 이력 (블록 길이의 배수)
+    PathState pathState = PathState::running;
+    int primePosition = 0;                           // 아직 흘려 보내지 않은 가장 오래된 이력 위치
+    SharedImpulseResponse::Ptr pendingSwitchIR;      // 페이드아웃이 끝나면 적용할 설계 (저장소가 참조를 들고 있음)
+    bool pendingSpectralSwitch = false;
+    bool pendingRenderSwitch = false;
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LoudnessCompensatorDSP)
 };
\ No newline at end of file
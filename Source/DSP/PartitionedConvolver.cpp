@@ -0,0 +1,312 @@
+/*
+  ==============================================================================
+
+    PartitionedConvolver.cpp
+    균일 분할 주파수 영역 컨볼루션 구현
+
+  ==============================================================================
+*/
+
+#include "PartitionedConvolver.h"
+#include <algorithm>
+
+PartitionedConvolver::PartitionedConvolver()
+{
+}
+
+PartitionedConvolver::~PartitionedConvolver()
+{
+}
+
+void PartitionedConvolver::prepare(int newPartitionSize, int maxImpulseLength, int numChannels, bool enableCoefficientRamp)
+{
+    jassert(juce::isPowerOfTwo(newPartitionSize));
+
+    partitionSize = newPartitionSize;
+    fftSize = partitionSize * 2;
+    numBins = partitionSize + 1;
+    numPartitions = juce::jmax(1, (maxImpulseLength + partitionSize - 1) / partitionSize);
+
+    fft = std::make_unique<juce::dsp::FFT>(static_cast<int>(std::log2(fftSize)));
+    fftBuffer.assign(static_cast<size_t>(fftSize * 2), 0.0f);
+
+    if (enableCoefficientRamp)
+        rampCoefficients.assign(static_cast<size_t>(numPartitions * numBins), Complex());
+    else
+        std::vector<Complex>().swap(rampCoefficients);
+
+    activeCoefficients = nullptr;
+    targetCoefficients = nullptr;
+    numActivePartitions = 0;
+    numTargetPartitions = 0;
+    firstActivePartition = 0;
+    firstTargetPartition = 0;
+    rampBlocksRemaining = 0;
+
+    channels.resize(static_cast<size_t>(numChannels));
+    for (auto& state : channels)
+    {
+        state.segments.assign(static_cast<size_t>(numPartitions * numBins), Complex());
+        state.tailAccumulator.assign(static_cast<size_t>(numBins), Complex());
+        state.inputBuffer.assign(static_cast<size_t>(partitionSize), 0.0f);
+        state.overlap.assign(static_cast<size_t>(partitionSize), 0.0f);
+    }
+
+    inputPosition = 0;
+    currentSegment = 0;
+}
+
+void PartitionedConvolver::reset()
+{
+    for (auto& state : channels)
+    {
+        std::fill(state.segments.begin(), state.segments.end(), Complex());
+        std::fill(state.tailAccumulator.begin(), state.tailAccumulator.end(), Complex());
+        std::fill(state.inputBuffer.begin(), state.inputBuffer.end(), 0.0f);
+        std::fill(state.overlap.begin(), state.overlap.end(), 0.0f);
+    }
+
+    inputPosition = 0;
+    currentSegment = 0;
+}
+
+void PartitionedConvolver::release()
+{
+    setImpulseSpectra(nullptr, 0);
+
+    fft.reset();
+    std::vector<float>().swap(fftBuffer);
+    std::vector<Complex>().swap(rampCoefficients);
+    std::vector<ChannelState>().swap(channels);
+
+    partitionSize = fftSize = numBins = numPartitions = 0;
+    inputPosition = 0;
+    currentSegment = 0;
+}
+
+size_t PartitionedConvolver::getStateMemoryUsage() const
+{
+    size_t total = fftBuffer.capacity() * sizeof(float);
+
+    for (const auto& state : channels)
+    {
+        total += (state.segments.capacity() + state.tailAccumulator.capacity()) * sizeof(Complex)
+               + (state.inputBuffer.capacity() + state.overlap.capacity()) * sizeof(float);
+    }
+
+    return total;
+}
+
+int PartitionedConvolver::transformImpulse(const float* impulse, int length, int partitionSize,
+                                           std::vector<Complex>& spectra)
+{
+    jassert(juce::isPowerOfTwo(partitionSize));
+
+    const int fftSize = partitionSize * 2;
+    juce::dsp::FFT transform(static_cast<int>(std::log2(fftSize)));
+    std::vector<float> buffer(static_cast<size_t>(fftSize * 2));
+
+    spectra.resize(static_cast<size_t>(getNumPartitions(length, partitionSize) * (partitionSize + 1)));
+    return transformImpulse(impulse, length, partitionSize, spectra.data(), transform, buffer.data());
+}
+
+int PartitionedConvolver::transformImpulse(const float* impulse, int length, int partitionSize, Complex* spectra,
+                                           const juce::dsp::FFT& transform, float* buffer)
+{
+    jassert(juce::isPowerOfTwo(partitionSize) && transform.getSize() == partitionSize * 2);
+
+    const int fftSize = partitionSize * 2;
+    const int numBins = partitionSize + 1;
+    const int partitionsUsed = getNumPartitions(length, partitionSize);
+
+    for (int p = 0; p < partitionsUsed; ++p)
+    {
+        const int offset = p * partitionSize;
+        const int count = juce::jmin(partitionSize, length - offset);
+
+        std::fill(buffer, buffer + fftSize * 2, 0.0f);
+        std::copy(impulse + offset, impulse + offset + count, buffer);
+
+        transform.performRealOnlyForwardTransform(buffer, true);
+
+        auto* bins = reinterpret_cast<const Complex*>(buffer);
+        std::copy(bins, bins + numBins, spectra + p * numBins);
+    }
+
+    return partitionsUsed;
+}
+
+void PartitionedConvolver::setImpulseSpectra(const Complex* spectra, int numPartitionsUsed, int firstPartition)
+{
+    activeCoefficients = spectra;
+    targetCoefficients = spectra;
+    numActivePartitions = spectra != nullptr ? juce::jlimit(0, numPartitions, numPartitionsUsed) : 0;
+    numTargetPartitions = numActivePartitions;
+    firstActivePartition = juce::jlimit(0, numActivePartitions, firstPartition);
+    firstTargetPartition = firstActivePartition;
+    rampBlocksRemaining = 0;
+}
+
+void PartitionedConvolver::setTargetImpulseSpectra(const Complex* spectra, int numPartitionsUsed, int rampBlocks, int firstPartition)
+{
+    // 아직 IR이 없으면 램프할 기준이 없으므로 즉시 교체
+    if (rampBlocks <= 0 || rampCoefficients.empty() || activeCoefficients == nullptr || spectra == nullptr)
+    {
+        setImpulseSpectra(spectra, numPartitionsUsed, firstPartition);
+        return;
+    }
+
+    // 현재 계수를 램프 버퍼로 복사 (이미 램프 중이면 그 상태에서 이어감)
+    if (activeCoefficients != rampCoefficients.data())
+    {
+        const auto activeCount = static_cast<size_t>(numActivePartitions * numBins);
+        std::copy(activeCoefficients, activeCoefficients + activeCount, rampCoefficients.begin());
+        std::fill(rampCoefficients.begin() + static_cast<std::ptrdiff_t>(activeCount), rampCoefficients.end(), Complex());
+        activeCoefficients = rampCoefficients.data();
+    }
+
+    targetCoefficients = spectra;
+    numTargetPartitions = juce::jlimit(0, numPartitions, numPartitionsUsed);
+    firstTargetPartition = juce::jlimit(0, numTargetPartitions, firstPartition);
+
+    // 램프 중에는 이전/목표 IR의 0이 아닌 파티션을 모두 처리
+    numActivePartitions = juce::jmax(numActivePartitions, numTargetPartitions);
+    firstActivePartition = juce::jmin(firstActivePartition, firstTargetPartition);
+    rampBlocksRemaining = rampBlocks;
+}
+
+void PartitionedConvolver::process(const juce::dsp::ProcessContextReplacing<float>& context)
+{
+    auto& block = context.getOutputBlock();
+
+    // IR이 없으면 통과
+    if (fft == nullptr || activeCoefficients == nullptr)
+        return;
+
+    const int numSamples = static_cast<int>(block.getNumSamples());
+    const int numChannels = juce::jmin(static_cast<int>(block.getNumChannels()),
+                                       static_cast<int>(channels.size()));
+
+    int processed = 0;
+
+    while (processed < numSamples)
+    {
+        const int count = juce::jmin(numSamples - processed, partitionSize - inputPosition);
+        const bool startOfBlock = (inputPosition == 0);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            processChannel(channels[static_cast<size_t>(ch)],
+                           block.getChannelPointer(static_cast<size_t>(ch)) + processed,
+                           count, startOfBlock);
+        }
+
+        inputPosition += count;
+        processed += count;
+
+        // 블록 완료: FDL 이동 후 계수 램프 한 단계
+        if (inputPosition == partitionSize)
+        {
+            inputPosition = 0;
+            currentSegment = (currentSegment > 0 ? currentSegment : numPartitions) - 1;
+
+            for (auto& state : channels)
+                std::fill(state.inputBuffer.begin(), state.inputBuffer.end(), 0.0f);
+
+            if (rampBlocksRemaining > 0)
+                advanceCoefficientRamp();
+        }
+    }
+}
+
+void PartitionedConvolver::processChannel(ChannelState& state, float* samples, int numSamples, bool startOfBlock)
+{
+    // 입력 누적 (in-place 처리이므로 출력 전에 먼저 복사)
+    std::copy(samples, samples + numSamples, state.inputBuffer.begin() + inputPosition);
+
+    // 현재 (부분) 블록 변환
+    std::fill(fftBuffer.begin(), fftBuffer.end(), 0.0f);
+    std::copy(state.inputBuffer.begin(), state.inputBuffer.end(), fftBuffer.begin());
+    fft->performRealOnlyForwardTransform(fftBuffer.data(), true);
+
+    auto* spectrum = reinterpret_cast<Complex*>(fftBuffer.data());
+    auto* segment = state.segments.data() + currentSegment * numBins;
+    std::copy(spectrum, spectrum + numBins, segment);
+
+    // 이전 파티션 기여분은 블록 시작 시 한 번만 계산
+    if (startOfBlock)
+    {
+        auto* tail = state.tailAccumulator.data();
+        std::fill(tail, tail + numBins, Complex());
+
+        for (int p = juce::jmax(1, firstActivePartition); p < numActivePartitions; ++p)
+        {
+            const int index = (currentSegment + p) % numPartitions;
+            const auto* input = state.segments.data() + index * numBins;
+            const auto* coeffs = activeCoefficients + p * numBins;
+
+            for (int b = 0; b < numBins; ++b)
+                tail[b] += input[b] * coeffs[b];
+        }
+    }
+
+    const auto* tail = state.tailAccumulator.data();
+    const auto* head = activeCoefficients;
+
+    // 첫 파티션이 0이면 이전 파티션 기여분만 사용 (활성 파티션이 없으면 FDL만 갱신하고 출력은 0)
+    if (firstActivePartition == 0 && numActivePartitions > 0)
+    {
+        for (int b = 0; b < numBins; ++b)
+            spectrum[b] = tail[b] + segment[b] * head[b];
+    }
+    else
+    {
+        std::copy(tail, tail + numBins, spectrum);
+    }
+
+    // 실수 역변환을 위한 켤레 대칭 구성
+    for (int b = numBins; b < fftSize; ++b)
+        spectrum[b] = std::conj(spectrum[fftSize - b]);
+
+    fft->performRealOnlyInverseTransform(fftBuffer.data());
+
+    // Overlap-add
+    for (int i = 0; i < numSamples; ++i)
+        samples[i] = fftBuffer[static_cast<size_t>(inputPosition + i)] + state.overlap[static_cast<size_t>(inputPosition + i)];
+
+    if (inputPosition + numSamples == partitionSize)
+        std::copy(fftBuffer.begin() + partitionSize, fftBuffer.begin() + fftSize, state.overlap.begin());
+}
+
+void PartitionedConvolver::advanceCoefficientRamp()
+{
+    // 남은 블록 수로 나눠 이동하면 시작 스펙트럼을 저장하지 않고도 선형 램프가 됨
+    const float step = 1.0f / static_cast<float>(rampBlocksRemaining);
+
+    for (int p = firstActivePartition; p < numActivePartitions; ++p)
+    {
+        auto* coeffs = rampCoefficients.data() + p * numBins;
+
+        if (p < numTargetPartitions)
+        {
+            const auto* target = targetCoefficients + p * numBins;
+
+            for (int b = 0; b < numBins; ++b)
+                coeffs[b] += (target[b] - coeffs[b]) * step;
+        }
+        else
+        {
+            // 목표 IR보다 긴 파티션은 0으로
+            for (int b = 0; b < numBins; ++b)
+                coeffs[b] -= coeffs[b] * step;
+        }
+    }
+
+    // 램프 종료: 목표 스펙트럼을 직접 참조
+    if (--rampBlocksRemaining == 0)
+    {
+        activeCoefficients = targetCoefficients;
+        numActivePartitions = numTargetPartitions;
+        firstActivePartition = firstTargetPartition;
+    }
+}
@@ -0,0 +1,105 @@
+/*
+  ==============================================================================
+
+    PartitionedConvolver.h
+    균일 분할 주파수 영역 컨볼루션 (제로 레이턴시, 파티션 계수 램프 지원)
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_dsp/juce_dsp.h>
+#include <vector>
+#include <complex>
+#include <memory>
+
+class PartitionedConvolver
+{
+public:
+    using Complex = std::complex<float>;
+
+    PartitionedConvolver();
+    ~PartitionedConvolver();
+
+    // IR을 파티션 스펙트럼 [파티션 수 * (partitionSize + 1)]으로 변환, 사용한 파티션 수 반환
+    static int transformImpulse(const float* impulse, int length, int partitionSize,
+                                std::vector<Complex>& spectra);
+
+    // 할당 없는 변환 (오디오 스레드 설계): spectra는 getNumPartitions 기준 크기,
+    // transform은 2 * partitionSize 길이 FFT, buffer는 4 * partitionSize개
+    static int transformImpulse(const float* impulse, int length, int partitionSize, Complex* spectra,
+                                const juce::dsp::FFT& transform, float* buffer);
+
+    static int getNumPartitions(int length, int partitionSize)
+    {
+        return (juce::jmax(0, length) + partitionSize - 1) / partitionSize;
+    }
+
+    // 모든 버퍼는 maxImpulseLength 기준으로 여기서 미리 할당
+    // 계수 램프를 쓰지 않으면 램프 버퍼는 할당하지 않음
+    void prepare(int partitionSize, int maxImpulseLength, int numChannels, bool enableCoefficientRamp = true);
+    void reset();
+    void release();  // 모든 버퍼 해제 (다시 prepare 전까지 통과)
+
+    // 스펙트럼은 복사하지 않고 빌려 씀: 다음 교체 전까지 호출자가 유효하게 유지해야 함
+    // numPartitionsUsed가 0이면 입력 이력(FDL)만 유지하고 출력은 0
+    // firstPartition 앞의 파티션은 0으로 보고 곱셈을 건너뜀
+    // IR 즉시 교체 (레이턴시가 바뀌는 경우)
+    void setImpulseSpectra(const Complex* spectra, int numPartitionsUsed, int firstPartition = 0);
+
+    // 목표 스펙트럼 설정: 각 파티션 계수를 rampBlocks 블록에 걸쳐 목표로 이동
+    // 블록당 추가 비용은 계수 갱신 한 번, 램프가 끝나면 목표 스펙트럼을 직접 참조
+    void setTargetImpulseSpectra(const Complex* spectra, int numPartitionsUsed, int rampBlocks, int firstPartition = 0);
+
+    void process(const juce::dsp::ProcessContextReplacing<float>& context);
+
+    bool isRamping() const { return rampBlocksRemaining > 0; }
+    bool hasImpulseResponse() const { return activeCoefficients != nullptr; }
+    int getPartitionSize() const { return partitionSize; }
+    int getNumActivePartitions() const { return numActivePartitions; }
+    int getFirstActivePartition() const { return firstActivePartition; }
+
+    // 상주 메모리 (FFT 객체 내부 테이블 제외)
+    size_t getStateMemoryUsage() const;
+    size_t getRampMemoryUsage() const { return rampCoefficients.capacity() * sizeof(Complex); }
+
+private:
+    struct ChannelState
+    {
+        std::vector<Complex> segments;        // 입력 스펙트럼 FDL [numPartitions * numBins]
+        std::vector<Complex> tailAccumulator; // 이전 파티션들의 누적 [numBins]
+        std::vector<float> inputBuffer;       // 현재 블록 입력 [partitionSize]
+        std::vector<float> overlap;           // 다음 블록으로 넘길 꼬리 [partitionSize]
+    };
+
+    void processChannel(ChannelState& state, float* samples, int numSamples, bool startOfBlock);
+    void advanceCoefficientRamp();
+
+    int partitionSize = 0;
+    int fftSize = 0;
+    int numBins = 0;
+    int numPartitions = 0;
+
+    int numActivePartitions = 0;
+    int numTargetPartitions = 0;
+    int firstActivePartition = 0;
+    int firstTargetPartition = 0;
+    int rampBlocksRemaining = 0;
+
+    int inputPosition = 0;
+    int currentSegment = 0;
+
+    std::unique_ptr<juce::dsp::FFT> fft;
+    std::vector<float> fftBuffer;  // [2 * fftSize]
+
+    // 파티션별 IR 스펙트럼: 빌린 스펙트럼 또는 램프 중에는 rampCoefficients
+    const Complex* activeCoefficients = nullptr;
+    const Complex* targetCoefficients = nullptr;
+    std::vector<Complex> rampCoefficients;  // [numPartitions * numBins]
+
+    std::vector<ChannelState> channels;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PartitionedConvolver)
+};
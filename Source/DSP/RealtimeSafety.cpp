@@ -0,0 +1,404 @@
+/*
+  ==============================================================================
+
+    RealtimeSafety.cpp
+    오디오 스레드 실시간 안전성 검사 구현
+
+  ==============================================================================
+*/
+
+#include "RealtimeSafety.h"
+
+#if LOUDNESS_REALTIME_CHECKS
+ #include <cstdio>
+ #include <cstdlib>
+ #include <new>
+
+ #if JUCE_LINUX && defined(__GLIBC__)
+  #define LOUDNESS_REALTIME_INTERPOSE 1
+  #include <dlfcn.h>
+  #include <pthread.h>
+  #include <semaphore.h>
+  #include <poll.h>
+  #include <sys/select.h>
+  #include <time.h>
+  #include <unistd.h>
+  #include <cerrno>
+ #else
+  #define LOUDNESS_REALTIME_INTERPOSE 0
+ #endif
+
+ // 가로챈 malloc 안에서도 읽으므로 TLS 접근이 할당을 일으키지 않도록 정적 TLS 모델
+ #if defined(__GNUC__)
+  #define LOUDNESS_STATIC_TLS __attribute__((tls_model("initial-exec")))
+ #else
+  #define LOUDNESS_STATIC_TLS
+ #endif
+
+namespace
+{
+    thread_local int markDepth LOUDNESS_STATIC_TLS = 0;
+    thread_local bool reporting LOUDNESS_STATIC_TLS = false;  // 보고 중 일어나는 할당/출력은 세지 않음
+
+    bool readAbortSetting()
+    {
+        const char* value = std::getenv("LOUDNESS_REALTIME_CHECKS_ABORT");
+        return value != nullptr && std::atoi(value) != 0;
+    }
+
+    std::atomic<bool> abortOnViolation { readAbortSetting() };
+    std::atomic<juce::int64> violationCounts[4] {};
+
+    const char* getViolationName(RealtimeSafety::Violation type)
+    {
+        switch (type)
+        {
+            case RealtimeSafety::Violation::allocation:   return "heap allocation";
+            case RealtimeSafety::Violation::deallocation: return "heap deallocation";
+            case RealtimeSafety::Violation::lock:         return "blocking lock";
+            case RealtimeSafety::Violation::blockingCall: return "blocking system call";
+        }
+
+        return "unknown";
+    }
+
+   #if LOUDNESS_REALTIME_INTERPOSE
+    extern "C"
+    {
+        void* __libc_malloc(size_t);
+        void* __libc_calloc(size_t, size_t);
+        void* __libc_realloc(void*, size_t);
+        void* __libc_memalign(size_t, size_t);
+        void __libc_free(void*);
+    }
+
+    void* allocateRaw(size_t size) { return __libc_malloc(size); }
+    void freeRaw(void* pointer) { __libc_free(pointer); }
+
+    // 원래 함수는 처음 불릴 때 찾음 (함수 안 static은 초기화 가드가 잠금을 쓰므로 원자 변수로 캐시)
+    // pthread_cond_*는 기본 버전을 명시하지 않으면 옛 호환 버전이 잡힐 수 있음
+    template <typename Function>
+    Function getOriginal(std::atomic<void*>& cache, const char* name, const char* version = nullptr)
+    {
+        void* function = cache.load(std::memory_order_acquire);
+
+        if (function == nullptr)
+        {
+            if (version != nullptr)
+                function = ::dlvsym(RTLD_NEXT, name, version);
+
+            if (function == nullptr)
+                function = ::dlsym(RTLD_NEXT, name);
+
+            cache.store(function, std::memory_order_release);
+        }
+
+        return reinterpret_cast<Function>(function);
+    }
+   #else
+    void* allocateRaw(size_t size) { return std::malloc(size); }
+    void freeRaw(void* pointer) { std::free(pointer); }
+   #endif
+
+    void* allocateChecked(size_t size, const char* function)
+    {
+        RealtimeSafety::check(RealtimeSafety::Violation::allocation, function);
+        return allocateRaw(size == 0 ? 1 : size);
+    }
+
+    void freeChecked(void* pointer, const char* function)
+    {
+        if (pointer != nullptr)
+            RealtimeSafety::check(RealtimeSafety::Violation::deallocation, function);
+
+        freeRaw(pointer);
+    }
+}
+
+RealtimeSafety::ScopedAudioThread::ScopedAudioThread(bool enabled)
+    : active(enabled)
+{
+    if (active)
+        ++markDepth;
+}
+
+RealtimeSafety::ScopedAudioThread::~ScopedAudioThread()
+{
+    if (active)
+        --markDepth;
+}
+
+bool RealtimeSafety::isAudioThreadMarked()
+{
+    return markDepth > 0;
+}
+
+void RealtimeSafety::setAbortOnViolation(bool shouldAbort)
+{
+    abortOnViolation.store(shouldAbort);
+}
+
+juce::int64 RealtimeSafety::getNumViolations()
+{
+    juce::int64 total = 0;
+    for (const auto& count : violationCounts)
+        total += count.load();
+
+    return total;
+}
+
+juce::int64 RealtimeSafety::getNumViolations(Violation type)
+{
+    return violationCounts[static_cast<int>(type)].load();
+}
+
+void RealtimeSafety::check(Violation type, const char* function)
+{
+    if (markDepth == 0 || reporting)
+        return;
+
+    // 보고는 그 자체로 할당/출력을 하므로 검사를 잠시 끄고 함
+    reporting = true;
+    const auto numViolations = violationCounts[static_cast<int>(type)].fetch_add(1) + 1;
+    const bool shouldAbort = abortOnViolation.load();
+
+    if (numViolations <= maxReportedViolations || shouldAbort)
+    {
+        const auto backtrace = juce::SystemStats::getStackBacktrace();
+        std::fprintf(stderr, "RealtimeSafety: %s on audio thread (%s)\n%s\n",
+                     getViolationName(type), function, backtrace.toRawUTF8());
+        std::fflush(stderr);
+    }
+
+    if (shouldAbort)
+        std::abort();
+
+    reporting = false;
+}
+
+//==============================================================================
+// operator new/delete 교체 (모든 플랫폼)
+// 정렬 지정 버전은 기본 구현이 aligned_alloc/free를 쓰므로 Linux에서는 아래 malloc 계열에서 잡힘
+void* operator new(std::size_t size)
+{
+    if (auto* pointer = allocateChecked(size, "operator new"))
+        return pointer;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    if (auto* pointer = allocateChecked(size, "operator new[]"))
+        return pointer;
+
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocateChecked(size, "operator new");
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocateChecked(size, "operator new[]");
+}
+
+void operator delete(void* pointer) noexcept                                 { freeChecked(pointer, "operator delete"); }
+void operator delete[](void* pointer) noexcept                               { freeChecked(pointer, "operator delete[]"); }
+void operator delete(void* pointer, std::size_t) noexcept                    { freeChecked(pointer, "operator delete"); }
+void operator delete[](void* pointer, std::size_t) noexcept                  { freeChecked(pointer, "operator delete[]"); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept          { freeChecked(pointer, "operator delete"); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept        { freeChecked(pointer, "operator delete[]"); }
+
+ #if LOUDNESS_REALTIME_INTERPOSE
+//==============================================================================
+// glibc 심볼 가로채기: 검사 후 원래 함수로 넘김
+extern "C"
+{
+    void* malloc(size_t size) __THROW
+    {
+        RealtimeSafety::check(RealtimeSafety::Violation::allocation, "malloc");
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t count, size_t size) __THROW
+    {
+        RealtimeSafety::check(RealtimeSafety::Violation::allocation, "calloc");
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* pointer, size_t size) __THROW
+    {
+        RealtimeSafety::check(RealtimeSafety::Violation::allocation, "realloc");
+        return __libc_realloc(pointer, size);
+    }
+
+    void* memalign(size_t alignment, size_t size) __THROW
+    {
+        RealtimeSafety::check(RealtimeSafety::Violation::allocation, "memalign");
+        return __libc_memalign(alignment, size);
+    }
+
+    void* aligned_alloc(size_t alignment, size_t size) __THROW
+    {
+        RealtimeSafety::check(RealtimeSafety::Violation::allocation, "aligned_alloc");
+        return __libc_memalign(alignment, size);
+    }
+
+    int posix_memalign(void** result, size_t alignment, size_t size) __THROW
+    {
+        RealtimeSafety::check(RealtimeSafety::Violation::allocation, "posix_memalign");
+
+        if (alignment < sizeof(void*) || (alignment & (alignment - 1)) != 0)
+            return EINVAL;
+
+        *result = __libc_memalign(alignment, size);
+        return *result != nullptr ? 0 : ENOMEM;
+    }
+
+    void free(void* pointer) __THROW
+    {
+        freeChecked(pointer, "free");
+    }
+
+    // 잠금/대기 (trylock은 막히지 않으므로 가로채지 않음)
+    int pthread_mutex_lock(pthread_mutex_t* mutex) __THROWNL
+    {
+        static std::atomic<void*> original { nullptr };
+        RealtimeSafety::check(RealtimeSafety::Violation::lock, "pthread_mutex_lock");
+        return getOriginal<int (*)(pthread_mutex_t*)>(original, "pthread_mutex_lock")(mutex);
+    }
+
+    int pthread_rwlock_rdlock(pthread_rwlock_t* rwlock) __THROWNL
+    {
+        static std::atomic<void*> original { nullptr };
+        RealtimeSafety::check(RealtimeSafety::Violation::lock, "pthread_rwlock_rdlock");
+        return getOriginal<int (*)(pthread_rwlock_t*)>(original, "pthread_rwlock_rdlock")(rwlock);
+    }
+
+    int pthread_rwlock_wrlock(pthread_rwlock_t* rwlock) __THROWNL
+    {
+        static std::atomic<void*> original { nullptr };
+        RealtimeSafety::check(RealtimeSafety::Violation::lock, "pthread_rwlock_wrlock");
+        return getOriginal<int (*)(pthread_rwlock_t*)>(original, "pthread_rwlock_wrlock")(rwlock);
+    }
+
+    int pthread_cond_wait(pthread_cond_t* condition, pthread_mutex_t* mutex)
+    {
+        static std::atomic<void*> original { nullptr };
+        RealtimeSafety::check(RealtimeSafety::Violation::lock, "pthread_cond_wait");
+        return getOriginal<int (*)(pthread_cond_t*, pthread_mutex_t*)>(original, "pthread_cond_wait", "GLIBC_2.3.2")(condition, mutex);
+    }
+
+    int pthread_cond_timedwait(pthread_cond_t* condition, pthread_mutex_t* mutex, const struct timespec* deadline)
+    {
+        static std::atomic<void*> original { nullptr };
+        RealtimeSafety::check(RealtimeSafety::Violation::lock, "pthread_cond_timedwait");
+        return getOriginal<int (*)(pthread_cond_t*, pthread_mutex_t*, const struct timespec*)>(original, "pthread_cond_timedwait", "GLIBC_2.3.2")(condition, mutex, deadline);
+    }
+
+    int sem_wait(sem_t* semaphore)
+    {
+        static std::atomic<void*> original { nullptr };
+        RealtimeSafety::check(RealtimeSafety::Violation::lock, "sem_wait");
+        return getOriginal<int (*)(sem_t*)>(original, "sem_wait")(semaphore);
+    }
+
+    // 막힐 수 있는 시스템 호출 (sleep, 파일/소켓 I/O)
+    int nanosleep(const struct timespec* duration, struct timespec* remaining)
+    {
+        static std::atomic<void*> original { nullptr };
+        RealtimeSafety::check(RealtimeSafety::Violation::blockingCall, "nanosleep");
+        return getOriginal<int (*)(const struct timespec*, struct timespec*)>(original, "nanosleep")(duration, remaining);
+    }
+
+    int clock_nanosleep(clockid_t clock, int flags, const struct timespec* duration, struct timespec* remaining)
+    {
+        static std::atomic<void*> original { nullptr };
+        RealtimeSafety::check(RealtimeSafety::Violation::blockingCall, "clock_nanosleep");
+        return getOriginal<int (*)(clockid_t, int, const struct timespec*, struct timespec*)>(original, "clock_nanosleep")(clock, flags, duration, remaining);
+    }
+
+    int usleep(useconds_t microseconds)
+    {
+        static std::atomic<void*> original { nullptr };
+        RealtimeSafety::check(RealtimeSafety::Violation::blockingCall, "usleep");
+        return getOriginal<int (*)(useconds_t)>(original, "usleep")(microseconds);
+    }
+
+    ssize_t read(int fd, void* buffer, size_t size)
+    {
+        static std::atomic<void*> original { nullptr };
+        RealtimeSafety::check(RealtimeSafety::Violation::blockingCall, "read");
+        return getOriginal<ssize_t (*)(int, void*, size_t)>(original, "read")(fd, buffer, size);
+    }
+
+    ssize_t write(int fd, const void* buffer, size_t size)
+    {
+        static std::atomic<void*> original { nullptr };
+        RealtimeSafety::check(RealtimeSafety::Violation::blockingCall, "write");
+        return getOriginal<ssize_t (*)(int, const void*, size_t)>(original, "write")(fd, buffer, size);
+    }
+
+    int fsync(int fd)
+    {
+        static std::atomic<void*> original { nullptr };
+        RealtimeSafety::check(RealtimeSafety::Violation::blockingCall, "fsync");
+        return getOriginal<int (*)(int)>(original, "fsync")(fd);
+    }
+
+    int poll(struct pollfd* fds, nfds_t numFds, int timeout)
+    {
+        static std::atomic<void*> original { nullptr };
+        RealtimeSafety::check(RealtimeSafety::Violation::blockingCall, "poll");
+        return getOriginal<int (*)(struct pollfd*, nfds_t, int)>(original, "poll")(fds, numFds, timeout);
+    }
+
+    int select(int numFds, fd_set* readFds, fd_set* writeFds, fd_set* exceptFds, struct timeval* timeout)
+    {
+        static std::atomic<void*> original { nullptr };
+        RealtimeSafety::check(RealtimeSafety::Violation::blockingCall, "select");
+        return getOriginal<int (*)(int, fd_set*, fd_set*, fd_set*, struct timeval*)>(original, "select")(numFds, readFds, writeFds, exceptFds, timeout);
+    }
+}
+ #endif
+
+#else
+
+// 옵션이 꺼져 있으면 표시만 하고 검사하지 않음
+RealtimeSafety::ScopedAudioThread::ScopedAudioThread(bool enabled)
+    : active(enabled)
+{
+}
+
+RealtimeSafety::ScopedAudioThread::~ScopedAudioThread()
+{
+    juce::ignoreUnused(active);
+}
+
+bool RealtimeSafety::isAudioThreadMarked()
+{
+    return false;
+}
+
+void RealtimeSafety::setAbortOnViolation(bool)
+{
+}
+
+juce::int64 RealtimeSafety::getNumViolations()
+{
+    return 0;
+}
+
+juce::int64 RealtimeSafety::getNumViolations(Violation)
+{
+    return 0;
+}
+
+void RealtimeSafety::check(Violation, const char*)
+{
+}
+
+#endif
@@ -0,0 +1,68 @@
+/*
+  ==============================================================================
+
+    RealtimeSafety.h
+    오디오 스레드 실시간 안전성 검사 (디버그/테스트 빌드 옵션)
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <atomic>
+
+// 빌드 옵션 LOUDNESS_REALTIME_CHECKS (CMake, 디버그/테스트 빌드용)
+// 꺼져 있으면 표시만 하는 빈 클래스이고 아무것도 가로채지 않음
+#ifndef LOUDNESS_REALTIME_CHECKS
+ #define LOUDNESS_REALTIME_CHECKS 0
+#endif
+
+// processBlock 동안 오디오 스레드를 표시하고, 표시된 스레드에서 일어난
+// 힙 할당/해제, 뮤텍스 잠금, 막힐 수 있는 시스템 호출을 위반으로 기록
+//
+// - operator new/delete: 모든 플랫폼 (전역 교체)
+// - malloc 계열, pthread 잠금/대기, 파일 I/O, sleep: glibc Linux만 (심볼 가로채기)
+// - 위반마다 종류와 스택 트레이스를 stderr로 출력 (종류마다 처음 maxReportedViolations개까지, 이후는 개수만)
+// - 환경 변수 LOUDNESS_REALTIME_CHECKS_ABORT=1 또는 setAbortOnViolation(true)면 출력 후 abort (CI 테스트)
+//
+// 심볼 가로채기는 실행 파일에 링크했을 때만 확실히 동작함 (Standalone, 테스트 실행 파일)
+// 호스트가 로드한 플러그인 바이너리에서는 호스트의 libc/libstdc++가 먼저 잡힐 수 있음
+// trylock은 막히지 않으므로 위반이 아님 (오디오 스레드의 ScopedTryLock 패턴)
+class RealtimeSafety
+{
+public:
+    enum class Violation
+    {
+        allocation,
+        deallocation,
+        lock,
+        blockingCall
+    };
+
+    static constexpr bool isEnabled() { return LOUDNESS_REALTIME_CHECKS != 0; }
+    static constexpr int maxReportedViolations = 32;
+
+    // 생성부터 소멸까지 현재 스레드를 오디오 스레드로 표시 (중첩 가능)
+    // 오프라인 렌더링처럼 실시간 제약이 없는 블록은 enabled = false
+    class ScopedAudioThread
+    {
+    public:
+        explicit ScopedAudioThread(bool enabled = true);
+        ~ScopedAudioThread();
+
+    private:
+        const bool active;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedAudioThread)
+    };
+
+    static bool isAudioThreadMarked();
+
+    static void setAbortOnViolation(bool shouldAbort);
+    static juce::int64 getNumViolations();
+    static juce::int64 getNumViolations(Violation type);
+
+    // 가로챈 함수에서 부름 (표시된 스레드가 아니면 아무것도 하지 않음)
+    static void check(Violation type, const char* function);
+};
@@ -0,0 +1,313 @@
+/*
+  ==============================================================================
+
+    SharedIRStore.cpp
+    프로세스 전역 공유 IR 저장소 구현
+
+  ==============================================================================
+*/
+
+#include "SharedIRStore.h"
+#include "PartitionedConvolver.h"
+#include <tuple>
+#include <algorithm>
+#include <cmath>
+
+bool FilterDesignKey::operator<(const FilterDesignKey& other) const
+{
+    return std::tie(targetPhon, referencePhon, filterTaps, sampleRate, partitionSize, latencyPadding,
+                    responseTolerance, engine)
+         < std::tie(other.targetPhon, other.referencePhon, other.filterTaps, other.sampleRate, other.partitionSize,
+                    other.latencyPadding, other.responseTolerance, other.engine);
+}
+
+bool FilterDesignKey::operator==(const FilterDesignKey& other) const
+{
+    return std::tie(targetPhon, referencePhon, filterTaps, sampleRate, partitionSize, latencyPadding,
+                    responseTolerance, engine)
+        == std::tie(other.targetPhon, other.referencePhon, other.filterTaps, other.sampleRate, other.partitionSize,
+                    other.latencyPadding, other.responseTolerance, other.engine);
+}
+
+//==============================================================================
+SharedImpulseResponse::SharedImpulseResponse(const FilterDesignKey& designedKey,
+                                             std::vector<float> designedCoefficients,
+                                             float designedPreampGain,
+                                             std::vector<float> designedIIRSections)
+    : key(designKey),
+      coefficients(designCoefficients),
+      preampGain(designPreampGain),
+      iirSections(designIIRSections),
+      designKey(designedKey),
+      designCoefficients(std::move(designedCoefficients)),
+      designPreampGain(designedPreampGain),
+      designIIRSections(std::move(designedIIRSections))
+{
+    if (!needsSpectra(designKey))
+        return;
+
+    // 컨볼버가 그대로 빌려 쓸 수 있도록 파티션 스펙트럼을 미리 계산
+    numPartitions = PartitionedConvolver::transformImpulse(designCoefficients.data(),
+                                                           static_cast<int>(designCoefficients.size()),
+                                                           designKey.partitionSize, spectra);
+    findFirstPartition();
+}
+
+SharedImpulseResponse::SharedImpulseResponse(int maxCoefficients, int maxIIRValues, int maxPartitionSize)
+    : key(designKey),
+      coefficients(designCoefficients),
+      preampGain(designPreampGain),
+      iirSections(designIIRSections)
+{
+    designCoefficients.reserve(static_cast<size_t>(maxCoefficients));
+    designIIRSections.reserve(static_cast<size_t>(maxIIRValues));
+
+    if (maxPartitionSize > 0)
+        spectra.reserve(static_cast<size_t>(PartitionedConvolver::getNumPartitions(maxCoefficients, maxPartitionSize)
+                                            * (maxPartitionSize + 1)));
+}
+
+bool SharedImpulseResponse::assign(const FilterDesignKey& newKey, int padding, const float* newCoefficients,
+                                   int numCoefficients, float newPreampGain, const float* newIIRSections,
+                                   int numIIRValues, DesignArena& arena)
+{
+    // 아직 아무도 빌려 가지 않은 항목만 (채운 뒤에는 불변)
+    jassert(getReferenceCount() <= 1 && designCoefficients.empty());
+
+    const int length = padding + numCoefficients;
+    const int partitionSize = needsSpectra(newKey) ? newKey.partitionSize : 0;
+
+    if (!hasCapacity(length, partitionSize) || static_cast<size_t>(numIIRValues) > designIIRSections.capacity())
+        return false;
+
+    // 변환 작업 버퍼를 먼저 잡아 두어 실패하면 항목을 건드리지 않음
+    const auto mark = arena.getMark();
+    auto* buffer = partitionSize > 0 ? arena.allocate<float>(4 * partitionSize) : nullptr;
+    if (partitionSize > 0 && buffer == nullptr)
+        return false;
+
+    designKey = newKey;
+    designPreampGain = newPreampGain;
+    designCoefficients.assign(static_cast<size_t>(padding), 0.0f);
+    designCoefficients.insert(designCoefficients.end(), newCoefficients, newCoefficients + numCoefficients);
+    designIIRSections.assign(newIIRSections, newIIRSections + numIIRValues);
+
+    if (partitionSize > 0)
+    {
+        spectra.resize(static_cast<size_t>(PartitionedConvolver::getNumPartitions(length, partitionSize) * (partitionSize + 1)));
+        numPartitions = PartitionedConvolver::transformImpulse(designCoefficients.data(), length, partitionSize, spectra.data(),
+                                                               arena.getFFT(juce::roundToInt(std::log2(2 * partitionSize))),
+                                                               buffer);
+        findFirstPartition();
+    }
+
+    arena.rewind(mark);
+    return true;
+}
+
+bool SharedImpulseResponse::hasCapacity(int numCoefficients, int partitionSize) const
+{
+    if (static_cast<size_t>(numCoefficients) > designCoefficients.capacity())
+        return false;
+
+    return partitionSize <= 0
+        || static_cast<size_t>(PartitionedConvolver::getNumPartitions(numCoefficients, partitionSize) * (partitionSize + 1))
+               <= spectra.capacity();
+}
+
+bool SharedImpulseResponse::needsSpectra(const FilterDesignKey& key)
+{
+    // 계수만 보관하는 항목은 파티션 크기가 정해진 뒤 다시 만들어 씀 (warped 계수는 컨볼버에 쓰지 않음)
+    return key.partitionSize > 0 && key.engine != FilterEngine::warped;
+}
+
+void SharedImpulseResponse::findFirstPartition()
+{
+    // 레이턴시 패딩으로 생긴 앞쪽 0 파티션은 컨볼버가 건너뜀
+    auto firstNonZero = std::find_if(designCoefficients.begin(), designCoefficients.end(), [](float c) { return c != 0.0f; });
+    firstPartition = juce::jmin(numPartitions,
+                                static_cast<int>(std::distance(designCoefficients.begin(), firstNonZero)) / designKey.partitionSize);
+}
+
+size_t SharedImpulseResponse::getMemoryUsage() const
+{
+    return sizeof(*this)
+         + (coefficients.capacity() + iirSections.capacity()) * sizeof(float)
+         + spectra.capacity() * sizeof(std::complex<float>);
+}
+
+//==============================================================================
+SharedIRStore::SharedIRStore()
+{
+    pending.reserve(reservedPendingEntries);
+}
+
+SharedIRStore::~SharedIRStore()
+{
+}
+
+SharedImpulseResponse::Ptr SharedIRStore::find(const FilterDesignKey& key) const
+{
+    const juce::ScopedLock sl(lock);
+
+    auto it = entries.find(key);
+    return it != entries.end() ? it->second : nullptr;
+}
+
+SharedImpulseResponse::Ptr SharedIRStore::tryFind(const FilterDesignKey& key) const
+{
+    const juce::ScopedTryLock sl(lock);
+    if (!sl.isLocked())
+        return nullptr;
+
+    auto it = entries.find(key);
+    return it != entries.end() ? it->second : nullptr;
+}
+
+SharedImpulseResponse::Ptr SharedIRStore::insert(SharedImpulseResponse::Ptr impulseResponse)
+{
+    jassert(impulseResponse != nullptr);
+
+    const juce::ScopedLock sl(lock);
+
+    auto result = entries.emplace(impulseResponse->key, impulseResponse);
+    return result.first->second;
+}
+
+SharedImpulseResponse::Ptr SharedIRStore::findOrCreate(const FilterDesignKey& key,
+                                                      const std::function<SharedImpulseResponse::Ptr()>& create)
+{
+    Claim entry;
+    bool creating = false;
+
+    {
+        const juce::ScopedLock sl(lock);
+
+        auto it = entries.find(key);
+        if (it != entries.end())
+            return it->second;
+
+        auto slot = findPending(key);
+        if (slot == pending.end())
+        {
+            pending.emplace_back(key, makeClaim());
+            slot = pending.end() - 1;
+            creating = true;
+        }
+
+        entry = slot->second;
+    }
+
+    if (!creating)
+    {
+        numJoined.fetch_add(1);
+        entry->done.wait(-1);
+        return entry->result;
+    }
+
+    numCreated.fetch_add(1);
+    return completeClaim(key, create());
+}
+
+SharedIRStore::Claim SharedIRStore::makeClaim()
+{
+    return std::make_shared<PendingEntry>();
+}
+
+SharedImpulseResponse::Ptr SharedIRStore::tryFindOrClaim(const FilterDesignKey& key, Claim& claim, bool& claimed)
+{
+    jassert(claim != nullptr);
+    claimed = false;
+
+    const juce::ScopedTryLock sl(lock);
+    if (!sl.isLocked())
+        return nullptr;
+
+    auto it = entries.find(key);
+    if (it != entries.end())
+        return it->second;
+
+    // 만드는 중인 키는 기다리지 않음 (결과는 저장소에 들어간 뒤 다음 블록에 찾음)
+    // 목록이 미리 잡은 크기만큼 찼으면 늘리지 않고 다음 블록에 다시
+    if (findPending(key) != pending.end() || pending.size() == pending.capacity())
+        return nullptr;
+
+    pending.emplace_back(key, std::move(claim));
+    numCreated.fetch_add(1);
+    claimed = true;
+    return nullptr;
+}
+
+SharedImpulseResponse::Ptr SharedIRStore::completeClaim(const FilterDesignKey& key,
+                                                       SharedImpulseResponse::Ptr impulseResponse)
+{
+    Claim entry;
+
+    {
+        const juce::ScopedLock sl(lock);
+
+        if (impulseResponse != nullptr)
+            impulseResponse = entries.emplace(key, impulseResponse).first->second;
+
+        // 기다리는 쪽은 결과를 entry로 받으므로 목록에서는 바로 지움 (실패해도 다음 요청은 다시 시도)
+        auto it = findPending(key);
+        jassert(it != pending.end());
+
+        if (it != pending.end())
+        {
+            entry = std::move(it->second);
+            entry->result = impulseResponse;
+            pending.erase(it);
+        }
+    }
+
+    if (entry != nullptr)
+        entry->done.signal();
+
+    return impulseResponse;
+}
+
+SharedIRStore::PendingList::iterator SharedIRStore::findPending(const FilterDesignKey& key)
+{
+    return std::find_if(pending.begin(), pending.end(), [&key](const auto& item) { return item.first == key; });
+}
+
+void SharedIRStore::releaseUnused()
+{
+    // 해제는 잠금 밖에서 (소멸자가 잠금을 오래 잡지 않도록)
+    std::vector<SharedImpulseResponse::Ptr> released;
+
+    {
+        const juce::ScopedLock sl(lock);
+
+        for (auto it = entries.begin(); it != entries.end();)
+        {
+            if (it->second->getReferenceCount() == 1)
+            {
+                released.push_back(std::move(it->second));
+                it = entries.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+}
+
+int SharedIRStore::getNumEntries() const
+{
+    const juce::ScopedLock sl(lock);
+    return static_cast<int>(entries.size());
+}
+
+size_t SharedIRStore::getTotalBytes() const
+{
+    const juce::ScopedLock sl(lock);
+
+    size_t total = 0;
+    for (const auto& entry : entries)
+        total += entry.second->getMemoryUsage();
+
+    return total;
+}
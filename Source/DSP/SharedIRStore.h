@@ -0,0 +1,155 @@
+/*
+  ==============================================================================
+
+    SharedIRStore.h
+    프로세스 전역 공유 IR 저장소 (설계 파라미터 키, 참조 카운트, 불변 스펙트럼)
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "DesignArena.h"
+#include <vector>
+#include <complex>
+#include <map>
+#include <memory>
+#include <functional>
+#include <atomic>
+#include <utility>
+
+// 필터 엔진: 선형 위상 FIR (분할 컨볼루션), 주파수 warping FIR (allpass 체인, 최소 위상),
+// hybrid (저역은 IIR shelf 단, 나머지는 짧은 선형 위상 FIR),
+// spectral (STFT bin별 gain, 설계/IR 없음: 저장소에 항목을 만들지 않음)
+enum class FilterEngine { linearPhase, warped, hybrid, spectral };
+
+// 설계 결과를 결정하는 파라미터 전체
+struct FilterDesignKey
+{
+    float targetPhon = 0.0f;
+    float referencePhon = 0.0f;
+    int filterTaps = 0;
+    double sampleRate = 0.0;
+    int partitionSize = 0;   // 0 = 계수만 있는 항목 (세션에서 복원, 스펙트럼 없음)
+    int latencyPadding = 0;  // 고정 레이턴시 모드에서 앞에 붙인 0 샘플 수
+    float responseTolerance = 0.0f;  // 허용 응답 오차 (dB, 0 = 항상 filterTaps 전체 길이)
+    FilterEngine engine = FilterEngine::linearPhase;  // warped: 계수만 (스펙트럼 없음, latencyPadding은 출력 지연)
+
+    bool operator<(const FilterDesignKey& other) const;
+    bool operator==(const FilterDesignKey& other) const;
+};
+
+// 설계된 IR과 파티션 스펙트럼 (생성 후 불변, 여러 인스턴스가 빌려 씀)
+class SharedImpulseResponse : public juce::ReferenceCountedObject
+{
+public:
+    using Ptr = juce::ReferenceCountedObjectPtr<SharedImpulseResponse>;
+
+    SharedImpulseResponse(const FilterDesignKey& key, std::vector<float> coefficients, float preampGain,
+                          std::vector<float> iirSections = {});
+
+    // 오디오 스레드 설계용 빈 항목: 버퍼만 미리 할당해 두고 assign()으로 한 번 채움
+    SharedImpulseResponse(int maxCoefficients, int maxIIRValues, int maxPartitionSize);
+
+    // 계수 앞에 padding개의 0을 붙여 채우고 스펙트럼 변환 (FFT와 작업 버퍼는 arena, 힙 할당 없음)
+    // 다른 스레드에 넘기거나 저장소에 넣기 전에만 호출, 미리 할당한 크기를 넘으면 false
+    bool assign(const FilterDesignKey& key, int padding, const float* coefficients, int numCoefficients,
+                float preampGain, const float* iirSections, int numIIRValues, DesignArena& arena);
+    bool hasCapacity(int numCoefficients, int partitionSize) const;
+
+    const FilterDesignKey& key;
+    const std::vector<float>& coefficients;
+    const float& preampGain;
+    const std::vector<float>& iirSections;  // hybrid 엔진의 IIR 단 계수 (BiquadCascade 형식, 나머지 엔진은 비어 있음)
+
+    const std::complex<float>* getSpectra() const { return spectra.data(); }
+    int getNumPartitions() const { return numPartitions; }
+    int getFirstPartition() const { return firstPartition; }  // 앞쪽 0 파티션 수
+    size_t getMemoryUsage() const;
+
+private:
+    static bool needsSpectra(const FilterDesignKey& key);
+    void findFirstPartition();
+
+    FilterDesignKey designKey;
+    std::vector<float> designCoefficients;
+    float designPreampGain = 0.0f;
+    std::vector<float> designIIRSections;
+
+    std::vector<std::complex<float>> spectra;
+    int numPartitions = 0;
+    int firstPartition = 0;
+
+    JUCE_DECLARE_NON_COPYABLE(SharedImpulseResponse)
+};
+
+// juce::SharedResourcePointer로 공유: 마지막 인스턴스가 사라질 때 해제됨
+//
+// 저장소가 항상 참조 하나를 들고 있으므로 오디오 스레드가 Ptr를 놓아도 해제되지 않음.
+// 실제 해제는 releaseUnused()에서만 일어나며 오디오 스레드에서 호출하면 안 됨.
+class SharedIRStore
+{
+public:
+    SharedIRStore();
+    ~SharedIRStore();
+
+    SharedImpulseResponse::Ptr find(const FilterDesignKey& key) const;
+
+    // 오디오 스레드용: 잠금을 기다리지 않음 (다른 스레드가 잡고 있으면 nullptr)
+    SharedImpulseResponse::Ptr tryFind(const FilterDesignKey& key) const;
+
+    // 같은 키가 이미 있으면 기존 항목을 반환
+    SharedImpulseResponse::Ptr insert(SharedImpulseResponse::Ptr impulseResponse);
+
+    // 없으면 create()로 만들어 등록 (잠금 밖에서 호출)
+    // 같은 키를 다른 스레드가 만드는 중이면 새로 만들지 않고 끝날 때까지 기다려 같은 결과를 받음
+    // (세션 로드나 링크된 트랙 자동화처럼 여러 인스턴스가 같은 설계를 동시에 요청해도 설계는 한 번)
+    // 기다릴 수 있으므로 작업 스레드/메시지 스레드/오프라인 렌더링에서만 호출
+    SharedImpulseResponse::Ptr findOrCreate(const FilterDesignKey& key,
+                                            const std::function<SharedImpulseResponse::Ptr()>& create);
+
+    // 예약 하나 (같은 키를 기다리는 스레드를 깨울 이벤트): 오디오 스레드가 할당하지 않도록 미리 만들어 넘김
+    struct PendingEntry
+    {
+        juce::WaitableEvent done { true };
+        SharedImpulseResponse::Ptr result;
+    };
+
+    using Claim = std::shared_ptr<PendingEntry>;
+    static Claim makeClaim();
+
+    // 오디오 스레드용 findOrCreate: 기다리지 않고, 아무도 만들고 있지 않으면 호출자가 만들기로 예약 (claimed = true)
+    // 예약하면 claim은 저장소로 옮겨짐 (nullptr이 되므로 다음 예약 전에 새로 만들어 둠)
+    // 다른 스레드가 같은 키를 만드는 중이거나, 잠금을 얻지 못하거나, 예약 목록이 미리 잡은 크기만큼 찼으면
+    // nullptr (현재 IR을 유지하고 다음 블록에 다시)
+    // 예약한 쪽은 결과를 (실패해도 nullptr로) completeClaim()에 넘겨야 하며,
+    // completeClaim은 잠금을 잡고 기다리는 스레드를 깨우므로 오디오 스레드가 아닌 곳에서 호출
+    SharedImpulseResponse::Ptr tryFindOrClaim(const FilterDesignKey& key, Claim& claim, bool& claimed);
+    SharedImpulseResponse::Ptr completeClaim(const FilterDesignKey& key, SharedImpulseResponse::Ptr impulseResponse);
+
+    // findOrCreate 통계: 직접 만든 횟수, 진행 중인 요청에 합쳐진 횟수
+    juce::int64 getNumCreated() const { return numCreated.load(); }
+    juce::int64 getNumJoined() const { return numJoined.load(); }
+
+    // 저장소 외에는 아무도 참조하지 않는 항목 해제
+    void releaseUnused();
+
+    int getNumEntries() const;
+    size_t getTotalBytes() const;
+
+private:
+    using PendingList = std::vector<std::pair<FilterDesignKey, Claim>>;
+    PendingList::iterator findPending(const FilterDesignKey& key);
+
+    // 동시에 만드는 키는 몇 개 안 되므로 미리 잡은 목록을 선형 탐색 (오디오 스레드 예약이 목록을 키우지 않도록)
+    static constexpr size_t reservedPendingEntries = 64;
+
+    juce::CriticalSection lock;
+    std::map<FilterDesignKey, SharedImpulseResponse::Ptr> entries;
+    PendingList pending;  // 만드는 중인 키
+    std::atomic<juce::int64> numCreated { 0 };
+    std::atomic<juce::int64> numJoined { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SharedIRStore)
+};
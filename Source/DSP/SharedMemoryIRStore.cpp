@@ -0,0 +1,298 @@
+/*
+  ==============================================================================
+
+    SharedMemoryIRStore.cpp
+    프로세스 간 공유 IR 저장소 구현
+
+  ==============================================================================
+*/
+
+#include "SharedMemoryIRStore.h"
+
+#if LOUDNESS_SHARED_MEMORY_STORE
+ #include <sys/mman.h>
+ #include <sys/stat.h>
+ #include <fcntl.h>
+ #include <unistd.h>
+ #include <cstring>
+ #include <type_traits>
+
+namespace
+{
+    // 세그먼트 배치가 바뀌면 이름과 layoutTag를 함께 바꿈 (이전 배치의 세그먼트와 섞이지 않도록)
+    constexpr const char* segmentName = "/LoudnessCompensator.IRs.2";
+    constexpr juce::uint64 layoutTag = 0x4c43495253000002ull;
+
+    static_assert(std::atomic<juce::uint64>::is_always_lock_free, "프로세스 간 원자 연산은 lock-free여야 함");
+
+    // 슬롯 제어 단어: 0 = 빈 슬롯, 아니면 레코드 위치 + 1 (레코드 영역 안의 바이트 오프셋)
+    constexpr juce::uint64 emptySlot = 0;
+
+    // 세그먼트 안의 키 (패딩까지 0으로 채워 바이트 단위로 비교/해시)
+    struct SharedKey
+    {
+        float targetPhon;
+        float referencePhon;
+        double sampleRate;
+        juce::int32 filterTaps;
+        juce::int32 latencyPadding;
+        float responseTolerance;
+        juce::int32 engine;
+        juce::uint32 designVersion;
+        juce::uint32 reserved;
+    };
+
+    SharedKey makeSharedKey(const FilterDesignKey& key, juce::uint32 designVersion)
+    {
+        SharedKey sharedKey;
+        std::memset(&sharedKey, 0, sizeof(sharedKey));
+        sharedKey.targetPhon = key.targetPhon;
+        sharedKey.referencePhon = key.referencePhon;
+        sharedKey.sampleRate = key.sampleRate;
+        sharedKey.filterTaps = key.filterTaps;
+        sharedKey.latencyPadding = key.latencyPadding;
+        sharedKey.responseTolerance = key.responseTolerance;
+        sharedKey.engine = static_cast<juce::int32>(key.engine);
+        sharedKey.designVersion = designVersion;
+        return sharedKey;
+    }
+
+    juce::uint64 hashKey(const SharedKey& key)
+    {
+        // FNV-1a
+        juce::uint64 hash = 14695981039346656037ull;
+        const auto* bytes = reinterpret_cast<const unsigned char*>(&key);
+
+        for (size_t i = 0; i < sizeof(key); ++i)
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+
+        return hash;
+    }
+
+    // 새로 만든 세그먼트는 0으로 채워져 있고, 0은 그대로 빈 테이블/빈 레코드 영역
+    struct Header
+    {
+        std::atomic<juce::uint64> layout;
+        std::atomic<juce::uint64> dataUsed;
+    };
+
+    struct Slot
+    {
+        std::atomic<juce::uint64> control;
+    };
+
+    // 레코드 영역의 항목: 머리 뒤에 계수, IIR 단 계수가 이어짐 (발행 전에 다 쓰고 이후 바뀌지 않음)
+    struct Record
+    {
+        juce::uint64 keyHash;
+        SharedKey key;
+        juce::uint32 numCoefficients;
+        juce::uint32 numIIRValues;
+        float preampGain;
+        juce::uint32 reserved;
+    };
+
+    static_assert(std::is_standard_layout<Header>::value && std::is_standard_layout<Slot>::value
+                  && std::is_standard_layout<Record>::value, "세그먼트 배치");
+    static_assert(sizeof(Record) % 16 == 0, "레코드 정렬");
+}
+
+struct SharedMemoryIRStore::Segment
+{
+    ~Segment()
+    {
+        ::munmap(mapping, size);
+    }
+
+    // 제어 단어가 가리키는 레코드 (다른 빌드/손상된 세그먼트에 대비해 범위를 벗어나면 nullptr)
+    const Record* getRecord(juce::uint64 control) const
+    {
+        const auto offset = control - 1;
+        if (control == emptySlot || offset > static_cast<juce::uint64>(dataBytes) - sizeof(Record))
+            return nullptr;
+
+        const auto* record = reinterpret_cast<const Record*>(data + offset);
+        const auto numValues = static_cast<juce::uint64>(record->numCoefficients) + record->numIIRValues;
+        if (numValues * sizeof(float) > static_cast<juce::uint64>(dataBytes) - offset - sizeof(Record))
+            return nullptr;
+
+        return record;
+    }
+
+    static bool matches(const Record* record, juce::uint64 hash, const SharedKey& key)
+    {
+        return record != nullptr && record->keyHash == hash && std::memcmp(&record->key, &key, sizeof(key)) == 0;
+    }
+
+    void* mapping = nullptr;
+    size_t size = 0;
+    Header* header = nullptr;
+    Slot* slots = nullptr;
+    char* data = nullptr;
+};
+
+SharedMemoryIRStore::SharedMemoryIRStore()
+{
+    const size_t size = sizeof(Header) + sizeof(Slot) * static_cast<size_t>(numSlots) + static_cast<size_t>(dataBytes);
+
+    // 같은 사용자의 프로세스끼리만 (0600)
+    const int fd = ::shm_open(segmentName, O_RDWR | O_CREAT, 0600);
+    if (fd < 0)
+        return;
+
+    // 크기가 다르면 다른 배치의 세그먼트이므로 쓰지 않음 (새로 만든 세그먼트는 크기 0)
+    struct stat info;
+    const bool sizeOk = ::fstat(fd, &info) == 0
+                     && (info.st_size == static_cast<off_t>(size) || (info.st_size == 0 && ::ftruncate(fd, static_cast<off_t>(size)) == 0));
+
+    void* mapping = sizeOk ? ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    ::close(fd);
+
+    if (mapping == MAP_FAILED)
+        return;
+
+    auto newSegment = std::make_unique<Segment>();
+    newSegment->mapping = mapping;
+    newSegment->size = size;
+    newSegment->header = static_cast<Header*>(mapping);
+    newSegment->slots = reinterpret_cast<Slot*>(static_cast<char*>(mapping) + sizeof(Header));
+    newSegment->data = reinterpret_cast<char*>(newSegment->slots + numSlots);
+
+    // 처음 연 프로세스가 배치 표시를 남김 (다른 표시가 있으면 사용하지 않음)
+    juce::uint64 expected = 0;
+    if (!newSegment->header->layout.compare_exchange_strong(expected, layoutTag) && expected != layoutTag)
+        return;
+
+    segment = std::move(newSegment);
+}
+
+SharedMemoryIRStore::~SharedMemoryIRStore()
+{
+    // 세그먼트는 지우지 않음 (다른 프로세스가 쓰는 중일 수 있고, 다음 실행도 재사용)
+}
+
+bool SharedMemoryIRStore::find(const FilterDesignKey& key, juce::uint32 designVersion, Entry& result) const
+{
+    if (segment == nullptr)
+        return false;
+
+    const auto sharedKey = makeSharedKey(key, designVersion);
+    const auto hash = hashKey(sharedKey);
+
+    for (int probe = 0; probe < maxProbes; ++probe)
+    {
+        const auto& slot = segment->slots[(hash + static_cast<juce::uint64>(probe)) % static_cast<juce::uint64>(numSlots)];
+        const auto control = slot.control.load(std::memory_order_acquire);
+
+        // 슬롯은 비워지지 않으므로 빈 슬롯이 나오면 그 뒤에도 없음
+        if (control == emptySlot)
+            return false;
+
+        const auto* record = segment->getRecord(control);
+        if (!Segment::matches(record, hash, sharedKey))
+            continue;
+
+        const auto* values = reinterpret_cast<const float*>(record + 1);
+        result.coefficients = values;
+        result.numCoefficients = static_cast<int>(record->numCoefficients);
+        result.iirSections = values + record->numCoefficients;
+        result.numIIRValues = static_cast<int>(record->numIIRValues);
+        result.preampGain = record->preampGain;
+
+        numHits.fetch_add(1);
+        return true;
+    }
+
+    return false;
+}
+
+bool SharedMemoryIRStore::publish(const FilterDesignKey& key, juce::uint32 designVersion,
+                                  const std::vector<float>& coefficients, float preampGain,
+                                  const std::vector<float>& iirSections)
+{
+    if (segment == nullptr || coefficients.empty())
+        return false;
+
+    const auto sharedKey = makeSharedKey(key, designVersion);
+    const auto hash = hashKey(sharedKey);
+    juce::uint64 recordControl = emptySlot;
+
+    for (int probe = 0; probe < maxProbes; ++probe)
+    {
+        auto& slot = segment->slots[(hash + static_cast<juce::uint64>(probe)) % static_cast<juce::uint64>(numSlots)];
+        auto control = slot.control.load(std::memory_order_acquire);
+
+        if (control == emptySlot)
+        {
+            // 빈 슬롯을 처음 만났을 때 레코드를 할당해 다 써 둠 (다른 프로세스는 발행 전까지 이 영역을 모름)
+            if (recordControl == emptySlot)
+            {
+                const auto numValues = coefficients.size() + iirSections.size();
+                const auto bytes = (sizeof(Record) + static_cast<juce::uint64>(numValues) * sizeof(float) + 15)
+                                 & ~static_cast<juce::uint64>(15);
+                const auto offset = segment->header->dataUsed.fetch_add(bytes);
+
+                // 가득 참: 슬롯은 건드리지 않음
+                if (offset + bytes > static_cast<juce::uint64>(dataBytes))
+                    return false;
+
+                auto* record = reinterpret_cast<Record*>(segment->data + offset);
+                std::memset(record, 0, sizeof(Record));
+                record->keyHash = hash;
+                record->key = sharedKey;
+                record->numCoefficients = static_cast<juce::uint32>(coefficients.size());
+                record->numIIRValues = static_cast<juce::uint32>(iirSections.size());
+                record->preampGain = preampGain;
+
+                auto* values = reinterpret_cast<float*>(record + 1);
+                std::memcpy(values, coefficients.data(), coefficients.size() * sizeof(float));
+                if (!iirSections.empty())
+                    std::memcpy(values + coefficients.size(), iirSections.data(), iirSections.size() * sizeof(float));
+
+                recordControl = offset + 1;
+            }
+
+            // 발행: release로 레코드 내용이 슬롯보다 먼저 보이게 함
+            if (slot.control.compare_exchange_strong(control, recordControl, std::memory_order_acq_rel))
+            {
+                numPublished.fetch_add(1);
+                return true;
+            }
+
+            // 다른 등록자가 먼저 채움 (control은 그쪽 레코드): 같은 키인지 아래에서 확인
+        }
+
+        if (Segment::matches(segment->getRecord(control), hash, sharedKey))
+            return false;
+    }
+
+    return false;
+}
+
+#else
+
+// 옵션이 꺼져 있으면 세그먼트를 열지 않음
+struct SharedMemoryIRStore::Segment
+{
+};
+
+SharedMemoryIRStore::SharedMemoryIRStore()
+{
+}
+
+SharedMemoryIRStore::~SharedMemoryIRStore()
+{
+}
+
+bool SharedMemoryIRStore::find(const FilterDesignKey&, juce::uint32, Entry&) const
+{
+    return false;
+}
+
+bool SharedMemoryIRStore::publish(const FilterDesignKey&, juce::uint32, const std::vector<float>&, float,
+                                  const std::vector<float>&)
+{
+    return false;
+}
+
+#endif
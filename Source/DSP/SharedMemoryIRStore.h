@@ -0,0 +1,76 @@
+/*
+  ==============================================================================
+
+    SharedMemoryIRStore.h
+    프로세스 간 공유 IR 저장소 (POSIX shared memory, 설계 계수만)
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "SharedIRStore.h"
+#include <vector>
+#include <memory>
+#include <atomic>
+
+// 빌드 옵션 LOUDNESS_SHARED_MEMORY_STORE (CMake, POSIX 플랫폼만)
+// 꺼져 있으면 항상 찾지 못하고 등록도 하지 않음
+#ifndef LOUDNESS_SHARED_MEMORY_STORE
+ #define LOUDNESS_SHARED_MEMORY_STORE 0
+#endif
+
+// 플러그인마다 별도 프로세스(샌드박스)로 띄우는 호스트에서 같은 머신의 프로세스끼리 설계 결과를 나눠 씀
+// juce::SharedResourcePointer로 프로세스 안에서는 하나만 열고, 세그먼트는 모든 프로세스가 같은 이름으로 엶
+//
+// 세그먼트: 헤더 + 고정 크기 슬롯 테이블(열린 주소법) + 레코드 영역(앞에서부터 할당만, 지우지 않음)
+// - 등록: 레코드(키, 계수)를 새로 할당한 영역에 다 쓴 뒤, 빈 슬롯을 그 레코드 위치로 CAS (원자적 발행)
+//   슬롯에 쓰는 것은 그 CAS 하나뿐이라 멈췄다 깨어난 등록자가 발행된 항목을 덮어쓸 수 없음
+// - 찾기: 준비된 슬롯이 가리키는 레코드만 읽음 (발행된 레코드는 다시 쓰이지 않음)
+// - 슬롯은 빈 상태 → 준비 상태로만 바뀌고 비워지지 않음 (같은 키를 동시에 등록하면 CAS에서 진 쪽의 레코드는 버림)
+// - 레코드 영역이 가득 차면 더 등록하지 않음 (슬롯은 건드리지 않고, 각 프로세스의 SharedIRStore는 그대로 동작)
+//
+// 키는 파티션 크기를 뺀 설계 파라미터와 설계 버전 (스펙트럼은 각 프로세스가 계수에서 만듦)
+// 세그먼트 접근은 원자 연산뿐이고 잠금, 대기, 힙 할당이 없음 (find는 세그먼트 안의 레코드를 복사하지 않고 가리킴)
+class SharedMemoryIRStore
+{
+public:
+    SharedMemoryIRStore();
+    ~SharedMemoryIRStore();
+
+    static constexpr int numSlots = 4096;
+    static constexpr juce::int64 dataBytes = 64 * 1024 * 1024;
+    static constexpr int maxProbes = 32;
+
+    // 세그먼트를 열지 못했으면 (옵션 꺼짐, 샌드박스 제한 등) false
+    bool isAvailable() const { return segment != nullptr; }
+
+    // 발행된 레코드는 바뀌지 않고 세그먼트는 저장소가 사라질 때까지 매핑되어 있으므로 그동안 유효
+    struct Entry
+    {
+        const float* coefficients = nullptr;
+        int numCoefficients = 0;
+        float preampGain = 0.0f;
+        const float* iirSections = nullptr;
+        int numIIRValues = 0;
+    };
+
+    bool find(const FilterDesignKey& key, juce::uint32 designVersion, Entry& result) const;
+
+    // 같은 키가 이미 있거나 자리가 없으면 false
+    bool publish(const FilterDesignKey& key, juce::uint32 designVersion, const std::vector<float>& coefficients,
+                 float preampGain, const std::vector<float>& iirSections);
+
+    juce::int64 getNumHits() const { return numHits.load(); }
+    juce::int64 getNumPublished() const { return numPublished.load(); }
+
+private:
+    struct Segment;
+    std::unique_ptr<Segment> segment;
+
+    mutable std::atomic<juce::int64> numHits { 0 };
+    std::atomic<juce::int64> numPublished { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SharedMemoryIRStore)
+};
@@ -0,0 +1,438 @@
+/*
+  ==============================================================================
+
+    SharedWorkerPool.cpp
+    프로세스 전역 작업 스레드 구현
+
+  ==============================================================================
+*/
+
+#include "SharedWorkerPool.h"
+#include <juce_dsp/juce_dsp.h>
+#include <atomic>
+#include <algorithm>
+
+namespace
+{
+    // 한 번의 parallelFor 호출 (작업자는 shared_ptr로 잡고 있으므로 호출이 끝난 뒤 늦게 깨어나도 안전)
+    struct ParallelBatch
+    {
+        const std::function<void(int, int)>* fn = nullptr;
+        int count = 0;
+        int chunkSize = 0;
+        int numChunks = 0;
+        std::atomic<int> nextChunk { 0 };
+        std::atomic<int> remainingChunks { 0 };
+        juce::WaitableEvent finished { true };
+
+        // 남은 구간이 없을 때까지 가져가서 실행 (fn은 구간을 가져간 뒤에만 씀: 호출한 쪽이 아직 기다리는 중)
+        void runChunks()
+        {
+            for (;;)
+            {
+                const int chunk = nextChunk.fetch_add(1);
+
+                if (chunk >= numChunks)
+                    return;
+
+                const int begin = chunk * chunkSize;
+                (*fn)(begin, juce::jmin(count, begin + chunkSize));
+
+                if (remainingChunks.fetch_sub(1) == 1)
+                    finished.signal();
+            }
+        }
+    };
+}
+
+//==============================================================================
+struct SharedWorkerPool::Client::State
+{
+    std::atomic<bool> alive { true };
+    int runningJobs = 0;                    // 풀의 lock으로 보호
+    juce::WaitableEvent idle { true };      // 실행 중인 작업이 없으면 신호 상태
+    juce::CriticalSection pollLock;         // 폴링 콜백 실행 ↔ 취소/소멸
+    std::function<void()> pollCallback;
+};
+
+class SharedWorkerPool::Worker : public juce::Thread
+{
+public:
+    explicit Worker(SharedWorkerPool& poolToUse)
+        : juce::Thread("Loudness worker"), pool(poolToUse)
+    {
+    }
+
+    ~Worker() override
+    {
+        stopThread(4000);
+    }
+
+    void run() override
+    {
+        while (!threadShouldExit())
+        {
+            if (!pool.runNextJob())
+                pool.workAvailable.wait(idleWaitMilliseconds);
+        }
+    }
+
+private:
+    static constexpr int idleWaitMilliseconds = 100;
+
+    SharedWorkerPool& pool;
+
+    JUCE_DECLARE_NON_COPYABLE(Worker)
+};
+
+class SharedWorkerPool::Poller : public juce::Thread
+{
+public:
+    explicit Poller(SharedWorkerPool& poolToUse)
+        : juce::Thread("Loudness request poller"), pool(poolToUse)
+    {
+    }
+
+    ~Poller() override
+    {
+        stopThread(4000);
+    }
+
+    void run() override
+    {
+        while (!threadShouldExit())
+        {
+            wait(pollIntervalMilliseconds);
+            pool.pollClients();
+        }
+    }
+
+private:
+    SharedWorkerPool& pool;
+
+    JUCE_DECLARE_NON_COPYABLE(Poller)
+};
+
+//==============================================================================
+SharedWorkerPool::SharedWorkerPool()
+    : numWorkers(juce::jlimit(1, maxWorkerThreads, juce::SystemStats::getNumCpus() - 1)),
+      numParallelHelpers(juce::jmin(numWorkers, juce::jmax(0, juce::SystemStats::getNumCpus() - 1)))
+{
+}
+
+SharedWorkerPool::~SharedWorkerPool()
+{
+    // 인스턴스(Client)가 모두 사라진 뒤이므로 남은 작업은 parallelFor 보조 작업뿐 (구간이 없으면 바로 끝남)
+    poller = nullptr;
+
+    for (auto& worker : workers)
+        worker->signalThreadShouldExit();
+
+    workers.clear();
+}
+
+SharedWorkerPool::Stats SharedWorkerPool::getStats() const
+{
+    const juce::ScopedLock sl(lock);
+
+    Stats stats;
+    stats.numWorkers = numWorkers;
+    stats.runningJobs = runningJobs;
+
+    for (int p = 0; p < numPriorities; ++p)
+    {
+        const auto index = static_cast<size_t>(p);
+        stats.queuedJobs[index] = static_cast<int>(queues[index].size());
+        stats.completedJobs[index] = completedJobs[index];
+        stats.averageWaitMilliseconds[index] = completedJobs[index] > 0 ? totalWaitMilliseconds[index] / static_cast<double>(completedJobs[index]) : 0.0;
+        stats.maxWaitMilliseconds[index] = maxWaitMilliseconds[index];
+    }
+
+    return stats;
+}
+
+void SharedWorkerPool::startWorkers()
+{
+    // lock 안에서 호출
+    if (!workers.empty())
+        return;
+
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        workers.push_back(std::make_unique<Worker>(*this));
+        workers.back()->startThread();
+    }
+}
+
+void SharedWorkerPool::addJob(Priority priority, Job job)
+{
+    job.submitTime = juce::Time::getMillisecondCounterHiRes();
+
+    {
+        const juce::ScopedLock sl(lock);
+        startWorkers();
+        queues[static_cast<size_t>(priority)].push_back(std::move(job));
+    }
+
+    workAvailable.signal();
+}
+
+bool SharedWorkerPool::runNextJob()
+{
+    Job job;
+    size_t priority = 0;
+
+    {
+        const juce::ScopedLock sl(lock);
+
+        for (;;)
+        {
+            while (priority < queues.size() && queues[priority].empty())
+                ++priority;
+
+            if (priority == queues.size())
+                return false;
+
+            job = std::move(queues[priority].front());
+            queues[priority].pop_front();
+
+            // 사라진 인스턴스의 작업은 건너뜀 (Client 소멸자가 지우기 전에 꺼낸 경우 없음: 같은 lock)
+            if (job.client == nullptr || job.client->alive.load())
+                break;
+        }
+
+        if (job.client != nullptr)
+            ++job.client->runningJobs;
+
+        ++runningJobs;
+
+        const double waitMilliseconds = juce::Time::getMillisecondCounterHiRes() - job.submitTime;
+        totalWaitMilliseconds[priority] += waitMilliseconds;
+        maxWaitMilliseconds[priority] = juce::jmax(maxWaitMilliseconds[priority], waitMilliseconds);
+
+        // 자동 리셋 이벤트라 신호가 합쳐졌을 수 있으므로 남은 작업이 있으면 다른 작업자도 깨움
+        for (const auto& queue : queues)
+        {
+            if (!queue.empty())
+            {
+                workAvailable.signal();
+                break;
+            }
+        }
+    }
+
+    job.run();
+
+    const juce::ScopedLock sl(lock);
+    --runningJobs;
+    ++completedJobs[priority];
+
+    if (job.client != nullptr && --job.client->runningJobs == 0)
+        job.client->idle.signal();
+
+    return true;
+}
+
+void SharedWorkerPool::pollClients()
+{
+    std::vector<std::shared_ptr<Client::State>> clients;
+
+    {
+        const juce::ScopedLock sl(lock);
+
+        pollingClients.erase(std::remove_if(pollingClients.begin(), pollingClients.end(),
+                                            [](const std::weak_ptr<Client::State>& client) { return client.expired(); }),
+                             pollingClients.end());
+
+        for (const auto& client : pollingClients)
+            if (auto state = client.lock())
+                clients.push_back(std::move(state));
+    }
+
+    for (const auto& state : clients)
+    {
+        const juce::ScopedLock pl(state->pollLock);
+
+        if (state->alive.load() && state->pollCallback != nullptr)
+            state->pollCallback();
+    }
+}
+
+//==============================================================================
+SharedWorkerPool::Client::Client(SharedWorkerPool& poolToUse)
+    : pool(poolToUse), state(std::make_shared<State>())
+{
+    state->idle.signal();
+}
+
+SharedWorkerPool::Client::~Client()
+{
+    shutdown();
+}
+
+void SharedWorkerPool::Client::shutdown()
+{
+    // 폴링 콜백이 끝난 뒤 끊고 나서 기다림 (기다리는 동안 폴링 스레드는 다른 인스턴스를 계속 돎)
+    {
+        const juce::ScopedLock pl(state->pollLock);
+        state->alive.store(false);
+        state->pollCallback = nullptr;
+    }
+
+    cancelJobs();
+}
+
+void SharedWorkerPool::Client::addJob(Priority priority, std::function<void()> job)
+{
+    if (!state->alive.load())
+        return;
+
+    Job entry;
+    entry.client = state;
+    entry.run = std::move(job);
+    pool.addJob(priority, std::move(entry));
+}
+
+void SharedWorkerPool::Client::setPollCallback(std::function<void()> callback)
+{
+    {
+        const juce::ScopedLock pl(state->pollLock);
+        state->pollCallback = std::move(callback);
+    }
+
+    const juce::ScopedLock sl(pool.lock);
+
+    if (pool.poller == nullptr)
+    {
+        pool.poller = std::make_unique<Poller>(pool);
+        pool.poller->startThread();
+    }
+
+    for (const auto& client : pool.pollingClients)
+        if (client.lock() == state)
+            return;
+
+    pool.pollingClients.push_back(state);
+}
+
+void SharedWorkerPool::Client::cancelJobs()
+{
+    // 실행 중인 작업은 오디오 스레드가 예약한 키를 기다릴 수 있고, 그 예약은 폴링 콜백이 넘기므로
+    // pollLock을 잡은 채 기다리면 안 됨 (폴링 스레드가 여기서 막혀 모든 인스턴스의 예약이 멈춤)
+    // 기다리는 동안 폴링 콜백이 넣은 작업은 다음 바퀴에 다시 지움
+    for (;;)
+    {
+        {
+            const juce::ScopedLock pl(state->pollLock);
+            const juce::ScopedLock sl(pool.lock);
+
+            for (auto& queue : pool.queues)
+                queue.erase(std::remove_if(queue.begin(), queue.end(),
+                                           [this](const Job& job) { return job.client == state; }),
+                            queue.end());
+
+            if (state->runningJobs == 0)
+                return;
+
+            state->idle.reset();
+        }
+
+        state->idle.wait(-1);
+    }
+}
+
+//==============================================================================
+void SharedWorkerPool::parallelFor(int count, int chunkSize, const std::function<void(int, int)>& fn)
+{
+    if (count <= 0)
+        return;
+
+    chunkSize = juce::jmax(1, chunkSize);
+    const int numChunks = (count + chunkSize - 1) / chunkSize;
+    const int numHelpers = juce::jmin(numParallelHelpers, numChunks - 1);
+
+    if (numHelpers <= 0)
+    {
+        for (int begin = 0; begin < count; begin += chunkSize)
+            fn(begin, juce::jmin(count, begin + chunkSize));
+
+        return;
+    }
+
+    auto batch = std::make_shared<ParallelBatch>();
+    batch->fn = &fn;
+    batch->count = count;
+    batch->chunkSize = chunkSize;
+    batch->numChunks = numChunks;
+    batch->remainingChunks = numChunks;
+
+    // 보조 작업은 설계 우선순위 (설계 작업 안에서 부르므로), 늦게 시작해서 남은 구간이 없으면 바로 끝남
+    for (int i = 0; i < numHelpers; ++i)
+    {
+        Job job;
+        job.run = [batch] { batch->runChunks(); };
+        addJob(Priority::design, std::move(job));
+    }
+
+    batch->runChunks();
+    batch->finished.wait(-1);
+}
+
+void SharedWorkerPool::performInverseFFT(std::complex<float>* data, int order)
+{
+    using Complex = std::complex<float>;
+
+    // n = n1 * n2, 입력 k = k1 + n1 * k2, 출력 m = n2 * m1 + m2
+    // x[m] = sum_k1 e^{2πi m1 k1 / n1} · e^{2πi m2 k1 / n} · (sum_k2 X[k1 + n1 k2] e^{2πi m2 k2 / n2})
+    const int order1 = order / 2;
+    const int order2 = order - order1;
+    const int n1 = 1 << order1;
+    const int n2 = 1 << order2;
+    const int n = n1 * n2;
+
+    std::vector<Complex> columns(static_cast<size_t>(n));  // [k1 * n2 + m2]
+    const int fftsPerChunk = juce::jmax(1, n1 / 32);
+
+    // 1단계: k1마다 간격 n1로 모은 n2점 역FFT (1/n2) 후 twiddle
+    parallelFor(n1, fftsPerChunk, [&](int begin, int end)
+    {
+        juce::dsp::FFT fft(order2);
+        std::vector<Complex> scratch(static_cast<size_t>(n2));
+
+        for (int k1 = begin; k1 < end; ++k1)
+        {
+            for (int k2 = 0; k2 < n2; ++k2)
+                scratch[static_cast<size_t>(k2)] = data[k1 + n1 * k2];
+
+            Complex* column = columns.data() + static_cast<size_t>(k1) * static_cast<size_t>(n2);
+            fft.perform(scratch.data(), column, true);
+
+            // 위상이 커지지 않도록 k1 * m2를 n으로 나눈 나머지로 계산
+            for (int m2 = 1; m2 < n2; ++m2)
+            {
+                const double phase = 2.0 * juce::MathConstants<double>::pi
+                                     * static_cast<double>((static_cast<juce::int64>(k1) * m2) % n) / n;
+                column[m2] *= Complex(static_cast<float>(std::cos(phase)), static_cast<float>(std::sin(phase)));
+            }
+        }
+    });
+
+    // 2단계: m2마다 k1 방향 n1점 역FFT (1/n1), 결과는 간격 n2로 제자리 기록 (입력은 1단계에서 모두 읽음)
+    parallelFor(n2, juce::jmax(1, n2 / 32), [&](int begin, int end)
+    {
+        juce::dsp::FFT fft(order1);
+        std::vector<Complex> scratch(static_cast<size_t>(n1));
+        std::vector<Complex> result(static_cast<size_t>(n1));
+
+        for (int m2 = begin; m2 < end; ++m2)
+        {
+            for (int k1 = 0; k1 < n1; ++k1)
+                scratch[static_cast<size_t>(k1)] = columns[static_cast<size_t>(k1) * static_cast<size_t>(n2) + static_cast<size_t>(m2)];
+
+            fft.perform(scratch.data(), result.data(), true);
+
+            for (int m1 = 0; m1 < n1; ++m1)
+                data[n2 * m1 + m2] = result[static_cast<size_t>(m1)];
+        }
+    });
+}
@@ -0,0 +1,130 @@
+/*
+  ==============================================================================
+
+    SharedWorkerPool.h
+    프로세스 전역 작업 스레드 (모든 인스턴스의 백그라운드 작업을 우선순위 대기열로 처리)
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <functional>
+#include <complex>
+#include <memory>
+#include <array>
+#include <deque>
+#include <vector>
+
+// juce::SharedResourcePointer로 모든 인스턴스가 공유
+// 스레드 수는 인스턴스 수와 무관하게 고정 (CPU 수 - 1, 최소 1, 최대 maxWorkerThreads)
+// 스레드는 처음 작업/폴링이 들어올 때 만듦 (스캔/생성 시에는 만들지 않음)
+class SharedWorkerPool
+{
+public:
+    SharedWorkerPool();
+    ~SharedWorkerPool();
+
+    static constexpr int maxWorkerThreads = 7;
+    static constexpr int pollIntervalMilliseconds = 10;
+
+    // 작업 우선순위: 대기열에서 항상 앞 단계부터 꺼냄
+    enum class Priority
+    {
+        design,      // 사용자가 기다리는 설계 (첫 설계, 점진 설계의 전체 길이)
+        loading,     // 이미 있는 계수의 스펙트럼 변환 (세션 복원)
+        speculative  // 추측 설계 (남는 시간에만)
+    };
+
+    static constexpr int numPriorities = 3;
+
+    // 대기열 상태 (에디터 타이머 등 어느 스레드에서 읽어도 됨)
+    struct Stats
+    {
+        int numWorkers = 0;
+        int runningJobs = 0;
+        std::array<int, numPriorities> queuedJobs {};
+        std::array<juce::int64, numPriorities> completedJobs {};
+        std::array<double, numPriorities> averageWaitMilliseconds {};  // 대기열에 들어가서 시작할 때까지
+        std::array<double, numPriorities> maxWaitMilliseconds {};
+    };
+
+    Stats getStats() const;
+
+    // 인스턴스별 작업 핸들: 인스턴스가 사라질 때 대기 중인 작업을 지우고 실행 중인 작업을 기다림
+    // 이후에는 이 핸들로 넣은 작업이나 폴링 콜백이 인스턴스를 건드리지 않음
+    class Client
+    {
+    public:
+        explicit Client(SharedWorkerPool& pool);
+        ~Client();
+
+        void addJob(Priority priority, std::function<void()> job);
+
+        // 폴링 스레드가 pollIntervalMilliseconds마다 호출 (오디오 스레드가 발행한 요청을 보고 작업을 넣는 용도)
+        void setPollCallback(std::function<void()> callback);
+
+        // 대기 중인 작업을 지우고 실행 중인 작업이 끝날 때까지 기다림
+        // 기다리는 동안에도 폴링 콜백은 돌아감 (실행 중인 작업이 기다리는 예약을 넘겨야 하므로)
+        // 작업 안이나 폴링 콜백 안에서 자기 핸들에 대해 부르면 안 됨
+        void cancelJobs();
+
+        // 폴링 콜백을 끊고 작업을 취소 (소멸자가 부름, 두 번 불러도 됨)
+        // 핸들을 비우기 전에 부르면 실행 중이던 폴링 콜백이 핸들을 쓰는 동안 핸들이 사라지지 않음
+        void shutdown();
+
+    private:
+        struct State;
+
+        SharedWorkerPool& pool;
+        std::shared_ptr<State> state;
+
+        friend class SharedWorkerPool;
+        JUCE_DECLARE_NON_COPYABLE(Client)
+    };
+
+    // [0, count)를 chunkSize 구간으로 나눠 fn(begin, end)를 호출하고 모두 끝날 때까지 기다림
+    // 호출한 스레드도 구간을 가져가므로 작업자가 모두 바쁘거나 없으면 혼자 끝냄 (작업자 안에서 불러도 안전)
+    // 구간 경계는 작업자 수와 무관하므로 구간별 부분합을 순서대로 더하면 결과가 항상 같음
+    void parallelFor(int count, int chunkSize, const std::function<void(int begin, int end)>& fn);
+
+    // 복소 역FFT (1/n 정규화 포함, 제자리)
+    // n = n1 * n2로 나눠 n1개의 n2점 FFT, twiddle, n2개의 n1점 FFT를 각각 구간으로 병렬 처리
+    void performInverseFFT(std::complex<float>* data, int order);
+
+    int getNumWorkers() const { return numWorkers; }
+
+private:
+    class Worker;
+    class Poller;
+
+    struct Job
+    {
+        std::shared_ptr<Client::State> client;  // nullptr = parallelFor 보조 작업
+        std::function<void()> run;
+        double submitTime = 0.0;
+    };
+
+    void addJob(Priority priority, Job job);
+    bool runNextJob();
+    void startWorkers();
+    void pollClients();
+
+    const int numWorkers;
+    const int numParallelHelpers;  // parallelFor가 나눠 줄 작업자 수 (단일 코어에서는 0)
+
+    mutable juce::CriticalSection lock;
+    std::array<std::deque<Job>, numPriorities> queues;
+    std::vector<std::weak_ptr<Client::State>> pollingClients;
+    juce::WaitableEvent workAvailable;
+    int runningJobs = 0;
+    std::array<juce::int64, numPriorities> completedJobs {};
+    std::array<double, numPriorities> totalWaitMilliseconds {};
+    std::array<double, numPriorities> maxWaitMilliseconds {};
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::unique_ptr<Poller> poller;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SharedWorkerPool)
+};
@@ -0,0 +1,264 @@
+/*
+  ==============================================================================
+
+    SpectralGainFilter.cpp
+    STFT 구간별 gain 필터 구현
+
+  ==============================================================================
+*/
+
+#include "SpectralGainFilter.h"
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <algorithm>
+
+SpectralGainFilter::SpectralGainFilter()
+{
+}
+
+SpectralGainFilter::~SpectralGainFilter()
+{
+}
+
+void SpectralGainFilter::prepare(double newSampleRate, int numChannels, int maxDelay)
+{
+    sampleRate = newSampleRate;
+
+    for (int order = minFrameOrder; order <= maxFrameOrder; ++order)
+    {
+        if (transforms[static_cast<size_t>(order - minFrameOrder)] == nullptr)
+            transforms[static_cast<size_t>(order - minFrameOrder)] = std::make_unique<juce::dsp::FFT>(order);
+    }
+
+    const size_t maxBins = static_cast<size_t>(maxFrameSize / 2 + 1);
+    analysisWindow.assign(static_cast<size_t>(maxFrameSize), 0.0f);
+    synthesisWindow.assign(static_cast<size_t>(maxFrameSize), 0.0f);
+    binLogFrequencies.assign(maxBins, 0.0f);
+    fftBuffer.assign(static_cast<size_t>(maxFrameSize * 2), 0.0f);
+    gains.assign(maxBins, 1.0f);
+    rampStartGains.assign(maxBins, 1.0f);
+    targetGains.assign(maxBins, 1.0f);
+    rampFrames = 0;
+    rampFramesRemaining = 0;
+
+    // 출력 누적은 현재 hop의 아직 읽지 않은 샘플 + 프레임 + 지연까지 담을 수 있어야 함
+    channels.resize(static_cast<size_t>(numChannels));
+    for (auto& state : channels)
+    {
+        state.inputRing.assign(static_cast<size_t>(maxFrameSize), 0.0f);
+        state.outputRing.assign(static_cast<size_t>(maxFrameSize * 2 + juce::jmax(0, maxDelay)), 0.0f);
+    }
+
+    delaySamples = 0;
+    setFrameSize(frameSize > 0 ? frameSize : 1024, hopSize > 0 ? hopSize : 256);
+}
+
+void SpectralGainFilter::reset()
+{
+    for (auto& state : channels)
+    {
+        std::fill(state.inputRing.begin(), state.inputRing.end(), 0.0f);
+        std::fill(state.outputRing.begin(), state.outputRing.end(), 0.0f);
+    }
+
+    hopPosition = 0;
+    inputPosition = 0;
+    outputPosition = 0;
+}
+
+void SpectralGainFilter::setFrameSize(int newFrameSize, int newHopSize)
+{
+    frameSize = juce::jlimit(minFrameSize, maxFrameSize, juce::nextPowerOfTwo(juce::jmax(1, newFrameSize)));
+    hopSize = juce::jlimit(frameSize / maxOverlap, frameSize / 2, juce::nextPowerOfTwo(juce::jmax(1, newHopSize)));
+
+    int order = minFrameOrder;
+    while ((1 << order) < frameSize)
+        ++order;
+
+    fft = transforms[static_cast<size_t>(order - minFrameOrder)].get();
+
+    // periodic Hann을 hop 간격으로 겹쳐 더하면 frameSize / (2 * hop)으로 일정
+    // 분석/합성에 제곱근을 나눠 쓰고 합성 쪽에 정규화를 넣어 gain이 1이면 입력이 그대로 나옴
+    const float overlapNormalisation = 2.0f * static_cast<float>(hopSize) / static_cast<float>(frameSize);
+
+    for (int n = 0; n < frameSize; ++n)
+    {
+        const float hann = 0.5f - 0.5f * std::cos(2.0f * juce::MathConstants<float>::pi * static_cast<float>(n) / static_cast<float>(frameSize));
+        analysisWindow[static_cast<size_t>(n)] = std::sqrt(hann);
+        synthesisWindow[static_cast<size_t>(n)] = std::sqrt(hann) * overlapNormalisation;
+    }
+
+    // DC bin은 가장 낮은 곡선 점 값을 쓰도록 음의 무한대 대신 가장 작은 값
+    binLogFrequencies[0] = std::numeric_limits<float>::lowest();
+    for (int k = 1; k <= frameSize / 2; ++k)
+        binLogFrequencies[static_cast<size_t>(k)] = static_cast<float>(std::log(k * sampleRate / frameSize));
+
+    // bin 배치가 바뀌었으므로 곡선은 호출한 쪽이 다시 설정할 때까지 평탄
+    std::fill(gains.begin(), gains.end(), 1.0f);
+    std::fill(targetGains.begin(), targetGains.end(), 1.0f);
+    rampFramesRemaining = 0;
+
+    reset();
+}
+
+void SpectralGainFilter::setDelay(int samples)
+{
+    const int maxDelay = channels.empty() ? 0 : static_cast<int>(channels.front().outputRing.size()) - maxFrameSize * 2;
+    delaySamples = juce::jlimit(0, maxDelay, samples);
+    reset();
+}
+
+void SpectralGainFilter::setGainCurve(const float* frequencies, const float* gainsDB, int numPoints, int rampSamples)
+{
+    if (numPoints <= 0 || frameSize == 0)
+        return;
+
+    // 램프 도중이면 지금 쓰고 있는 gain에서 다시 시작
+    const int numBins = frameSize / 2 + 1;
+    std::copy(gains.begin(), gains.begin() + numBins, rampStartGains.begin());
+
+    // bin과 곡선 점이 모두 오름차순이므로 구간마다 로그를 한 번만 계산하며 함께 진행
+    const float firstLog = std::log(frequencies[0]);
+    int k = 0;
+
+    for (; k < numBins && binLogFrequencies[static_cast<size_t>(k)] <= firstLog; ++k)
+        targetGains[static_cast<size_t>(k)] = juce::Decibels::decibelsToGain(gainsDB[0]);
+
+    for (int j = 0; j < numPoints - 1 && k < numBins; ++j)
+    {
+        const float lowLog = std::log(frequencies[j]);
+        const float highLog = std::log(frequencies[j + 1]);
+
+        for (; k < numBins && binLogFrequencies[static_cast<size_t>(k)] < highLog; ++k)
+        {
+            const float t = (binLogFrequencies[static_cast<size_t>(k)] - lowLog) / (highLog - lowLog);
+            targetGains[static_cast<size_t>(k)] = juce::Decibels::decibelsToGain(gainsDB[j] + t * (gainsDB[j + 1] - gainsDB[j]));
+        }
+    }
+
+    for (; k < numBins; ++k)
+        targetGains[static_cast<size_t>(k)] = juce::Decibels::decibelsToGain(gainsDB[numPoints - 1]);
+
+    if (rampSamples > 0)
+    {
+        rampFrames = (rampSamples + hopSize - 1) / hopSize;
+        rampFramesRemaining = rampFrames;
+    }
+    else
+    {
+        std::copy(targetGains.begin(), targetGains.begin() + numBins, gains.begin());
+        rampFramesRemaining = 0;
+    }
+}
+
+void SpectralGainFilter::advanceGainRamp()
+{
+    --rampFramesRemaining;
+
+    const float t = 1.0f - static_cast<float>(rampFramesRemaining) / static_cast<float>(rampFrames);
+    const int numBins = frameSize / 2 + 1;
+
+    for (int k = 0; k < numBins; ++k)
+    {
+        const float start = rampStartGains[static_cast<size_t>(k)];
+        gains[static_cast<size_t>(k)] = start + t * (targetGains[static_cast<size_t>(k)] - start);
+    }
+}
+
+void SpectralGainFilter::process(const juce::dsp::ProcessContextReplacing<float>& context)
+{
+    auto& block = context.getOutputBlock();
+    const int numSamples = static_cast<int>(block.getNumSamples());
+    const int numChannels = juce::jmin(static_cast<int>(block.getNumChannels()), static_cast<int>(channels.size()));
+
+    if (numChannels == 0 || fft == nullptr)
+        return;
+
+    const int inputMask = maxFrameSize - 1;
+    const int outputLength = static_cast<int>(channels.front().outputRing.size());
+
+    // hop 경계까지 끊어서 처리: 경계를 채운 샘플이 들어오면 프레임을 계산한 뒤 출력을 읽음
+    for (int done = 0; done < numSamples;)
+    {
+        const int count = juce::jmin(numSamples - done, hopSize - hopPosition);
+        const bool frameComplete = hopPosition + count == hopSize;
+
+        if (frameComplete && rampFramesRemaining > 0)
+            advanceGainRamp();
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto& state = channels[static_cast<size_t>(ch)];
+            float* samples = block.getChannelPointer(static_cast<size_t>(ch)) + done;
+
+            for (int i = 0; i < count; ++i)
+                state.inputRing[static_cast<size_t>((inputPosition + i) & inputMask)] = samples[i];
+
+            if (frameComplete)
+                processFrame(state, count);
+
+            for (int i = 0; i < count; ++i)
+            {
+                auto& slot = state.outputRing[static_cast<size_t>((outputPosition + i) % outputLength)];
+                samples[i] = slot;
+                slot = 0.0f;
+            }
+        }
+
+        inputPosition = (inputPosition + count) & inputMask;
+        outputPosition = (outputPosition + count) % outputLength;
+        hopPosition = frameComplete ? 0 : hopPosition + count;
+        done += count;
+    }
+}
+
+void SpectralGainFilter::processFrame(ChannelState& state, int samplesAhead)
+{
+    using Complex = std::complex<float>;
+
+    // 방금 들어온 샘플까지의 최근 frameSize 입력
+    const int inputMask = maxFrameSize - 1;
+    const int oldest = (inputPosition + samplesAhead - frameSize) & inputMask;
+
+    for (int n = 0; n < frameSize; ++n)
+        fftBuffer[static_cast<size_t>(n)] = state.inputRing[static_cast<size_t>((oldest + n) & inputMask)] * analysisWindow[static_cast<size_t>(n)];
+
+    std::fill(fftBuffer.begin() + frameSize, fftBuffer.end(), 0.0f);
+    fft->performRealOnlyForwardTransform(fftBuffer.data(), true);
+
+    // 실수 gain이므로 영위상: 실수 역변환을 위해 켤레 대칭 구성
+    auto* spectrum = reinterpret_cast<Complex*>(fftBuffer.data());
+    const int numBins = frameSize / 2 + 1;
+
+    for (int b = 0; b < numBins; ++b)
+        spectrum[b] *= gains[static_cast<size_t>(b)];
+
+    for (int b = numBins; b < frameSize; ++b)
+        spectrum[b] = std::conj(spectrum[frameSize - b]);
+
+    fft->performRealOnlyInverseTransform(fftBuffer.data());
+
+    // 프레임 첫 샘플이 frameSize - 1 (+ 지연) 뒤에 나오도록 현재 샘플 위치부터 누적
+    const int outputLength = static_cast<int>(state.outputRing.size());
+    int slot = (outputPosition + samplesAhead - 1 + delaySamples) % outputLength;
+
+    for (int n = 0; n < frameSize; ++n)
+    {
+        state.outputRing[static_cast<size_t>(slot)] += fftBuffer[static_cast<size_t>(n)] * synthesisWindow[static_cast<size_t>(n)];
+
+        if (++slot == outputLength)
+            slot = 0;
+    }
+}
+
+size_t SpectralGainFilter::getStateMemoryUsage() const
+{
+    size_t bytes = (analysisWindow.capacity() + synthesisWindow.capacity() + binLogFrequencies.capacity()
+                    + fftBuffer.capacity() + gains.capacity() + rampStartGains.capacity() + targetGains.capacity()) * sizeof(float);
+
+    for (const auto& state : channels)
+        bytes += (state.inputRing.capacity() + state.outputRing.capacity()) * sizeof(float);
+
+    return bytes;
+}
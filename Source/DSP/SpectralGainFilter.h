@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+    SpectralGainFilter.h
+    STFT 구간별 gain 필터 (windowed overlap-add, FIR 설계 없음)
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_dsp/juce_dsp.h>
+#include <vector>
+#include <array>
+#include <memory>
+
+// sqrt-Hann 분석/합성 창으로 프레임마다 FFT → bin별 실수 gain → 역FFT → overlap-add
+// 레이턴시는 frameSize - 1 (+ 출력 지연), 주파수 해상도는 sampleRate / frameSize
+class SpectralGainFilter
+{
+public:
+    SpectralGainFilter();
+    ~SpectralGainFilter();
+
+    static constexpr int minFrameSize = 256;
+    static constexpr int maxFrameSize = 2048;
+    static constexpr int maxOverlap = 8;  // hop은 frameSize / 2 ~ frameSize / maxOverlap
+
+    // 모든 버퍼와 FFT는 최대 프레임 기준으로 여기서 미리 할당
+    void prepare(double sampleRate, int numChannels, int maxDelay);
+    void reset();
+
+    // 프레임/hop 변경 (할당 없음, 상태는 비워지므로 필요하면 호출한 쪽이 다시 채움)
+    // 2의 거듭제곱으로 맞추고 hop은 frameSize의 1/2 ~ 1/maxOverlap로 제한
+    void setFrameSize(int newFrameSize, int newHopSize);
+    int getFrameSize() const { return frameSize; }
+    int getHopSize() const { return hopSize; }
+
+    // 고정 레이턴시용 출력 지연 (상태는 비워짐)
+    void setDelay(int samples);
+    int getDelay() const { return delaySamples; }
+    int getLatencySamples() const { return frameSize - 1 + delaySamples; }
+
+    // 주파수별 gain(dB, 오름차순 주파수)을 로그 주파수로 보간해 bin gain 계산 (범위 밖은 양 끝 값)
+    // rampSamples 동안 프레임마다 이전 gain에서 선형으로 옮겨 감, 0이면 즉시 교체
+    void setGainCurve(const float* frequencies, const float* gainsDB, int numPoints, int rampSamples);
+
+    void process(const juce::dsp::ProcessContextReplacing<float>& context);
+
+    bool isRamping() const { return rampFramesRemaining > 0; }
+
+    size_t getStateMemoryUsage() const;
+
+private:
+    struct ChannelState
+    {
+        std::vector<float> inputRing;    // 최근 maxFrameSize 입력
+        std::vector<float> outputRing;   // overlap-add 누적 (maxFrameSize + maxDelay)
+    };
+
+    void processFrame(ChannelState& state, int outputOffset);
+    void advanceGainRamp();
+
+    static constexpr int minFrameOrder = 8;
+    static constexpr int maxFrameOrder = 11;
+
+    std::array<std::unique_ptr<juce::dsp::FFT>, maxFrameOrder - minFrameOrder + 1> transforms;
+    juce::dsp::FFT* fft = nullptr;
+
+    double sampleRate = 48000.0;
+    int frameSize = 0;
+    int hopSize = 0;
+    int delaySamples = 0;
+    int hopPosition = 0;      // 현재 hop에서 받은 샘플 수
+    int inputPosition = 0;    // inputRing 쓰기 위치
+    int outputPosition = 0;   // outputRing 읽기 위치
+
+    std::vector<float> analysisWindow;
+    std::vector<float> synthesisWindow;  // overlap 합 정규화 포함
+    std::vector<float> binLogFrequencies;
+    std::vector<float> fftBuffer;
+
+    // bin gain (선형): 프레임마다 gains를 사용, 램프 중에는 rampStartGains → targetGains
+    std::vector<float> gains;
+    std::vector<float> rampStartGains;
+    std::vector<float> targetGains;
+    int rampFrames = 0;
+    int rampFramesRemaining = 0;
+
+    std::vector<ChannelState> channels;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectralGainFilter)
+};
@@ -0,0 +1,63 @@
+/*
+  ==============================================================================
+
+    TripleBuffer.h
+    단일 쓰기/단일 읽기 트리플 버퍼 (읽기 쪽 wait-free)
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+
+// 쓰기 쪽은 자기 버퍼를 채운 뒤 publish()로 가운데 버퍼와 교환하고,
+// 읽기 쪽은 새 값이 있을 때만 acquire()로 가운데 버퍼와 교환함
+// 두 쪽 모두 원자적 교환 한 번뿐이므로 서로를 기다리지 않으며, 읽는 값이 찢어지지 않음
+// 쓰기 스레드가 여럿이면 호출자가 쓰기끼리 직렬화해야 함
+template <typename Type>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+
+    explicit TripleBuffer(const Type& initialValue)
+    {
+        for (auto& buffer : buffers)
+            buffer = initialValue;
+    }
+
+    // 쓰기 쪽: 값을 채우고 발행 (마지막으로 발행한 값만 읽기 쪽에 보임)
+    Type& getWriteBuffer() { return buffers[writeIndex]; }
+
+    void publish()
+    {
+        const int previous = middle.exchange(writeIndex | newDataFlag, std::memory_order_acq_rel);
+        writeIndex = previous & indexMask;
+    }
+
+    // 읽기 쪽: 새로 발행된 값이 있으면 가져오고 true
+    bool acquire()
+    {
+        if ((middle.load(std::memory_order_acquire) & newDataFlag) == 0)
+            return false;
+
+        const int previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & indexMask;
+        return true;
+    }
+
+    const Type& getReadBuffer() const { return buffers[readIndex]; }
+
+    // 읽기 쪽: 가져가지 않은 새 값이 있는지만 확인
+    bool hasPending() const { return (middle.load(std::memory_order_acquire) & newDataFlag) != 0; }
+
+private:
+    static constexpr int indexMask = 3;
+    static constexpr int newDataFlag = 4;
+
+    Type buffers[3];
+    int writeIndex = 0;
+    std::atomic<int> middle { 1 };
+    int readIndex = 2;
+};
@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+    WarpedFIRFilter.h
+    주파수 warping FIR (1차 allpass 체인, 최소 위상, 계수 램프 지원)
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_dsp/juce_dsp.h>
+#include <vector>
+#include <complex>
+
+// 지연 소자 z^-1을 1차 allpass D(z) = (z^-1 - lambda) / (1 - lambda z^-1)로 바꾼 FIR
+// lambda > 0이면 저역이 넓게 펼쳐진 warped 주파수 축에서 설계하므로 적은 탭으로 저역 해상도를 얻음
+class WarpedFIRFilter
+{
+public:
+    WarpedFIRFilter();
+    ~WarpedFIRFilter();
+
+    // 샘플레이트에 맞춘 warping 계수 (저역 해상도가 샘플레이트와 무관하도록)
+    static double getWarpingFactor(double sampleRate);
+
+    // 실제 주파수(rad/sample) → warped 주파수
+    static double warpFrequency(double omega, double lambda);
+
+    // warped 축 설계 해상도 (켑스트럼 계산용 FFT 차수)
+    static constexpr int designFFTOrder = 12;
+    static constexpr int designFFTSize = 1 << designFFTOrder;
+
+    // 주파수별 gain(dB, 오름차순 주파수)에서 최소 위상 warped 계수 numTaps개를 result에 설계 (1 kHz에서 0 dB)
+    // 점 사이는 로그 주파수에서 dB 선형 보간, 범위 밖은 양 끝 값 유지
+    // fft는 designFFTOrder 차수, workspace는 2 * designFFTSize개 (호출자가 미리 할당, 여기서는 할당 없음)
+    static void design(const float* frequencies, const float* gainsDB, int numPoints,
+                       int numTaps, double sampleRate, double lambda,
+                       const juce::dsp::FFT& fft, std::complex<float>* workspace, float* result);
+
+    // warped 계수의 실제 주파수 응답 크기 (dB)
+    static float getMagnitudeDB(const std::vector<float>& coefficients, double frequency,
+                                double sampleRate, double lambda);
+    static float getMagnitudeDB(const float* coefficients, int numTaps, double frequency,
+                                double sampleRate, double lambda);
+
+    // 모든 버퍼는 여기서 미리 할당 (maxDelay = 고정 레이턴시용 출력 지연 최대 길이)
+    void prepare(int maxTaps, int numChannels, int maxDelay);
+    void reset();
+
+    void setWarpingFactor(double lambda);
+    double getWarpingFactor() const { return warpingFactor; }
+
+    // 계수는 복사해서 보관 (길이는 prepare의 maxTaps 이하)
+    // rampSamples 동안 이전 계수에서 선형으로 이동, 0이면 즉시 교체
+    void setCoefficients(const std::vector<float>& newCoefficients, int rampSamples);
+
+    // 출력 지연 (고정 레이턴시 모드에서 FIR 경로와 레이턴시를 맞춤)
+    void setDelay(int samples);
+
+    void process(const juce::dsp::ProcessContextReplacing<float>& context);
+
+    bool isRamping() const { return rampSamplesRemaining > 0; }
+    int getNumTaps() const { return numTaps; }
+
+    size_t getStateMemoryUsage() const;
+
+private:
+    struct ChannelState
+    {
+        std::vector<float> stages;  // 각 allpass 단의 이전 출력 x_k[n-1]
+        std::vector<float> delayLine;
+        int delayPosition = 0;
+    };
+
+    void processChannel(ChannelState& state, float* samples, int numSamples);
+
+    double warpingFactor = 0.0;
+    int numTaps = 0;
+    int targetTaps = 0;
+    int delaySamples = 0;
+
+    // 램프 중에는 같은 allpass 체인 출력에 두 계수 묶음을 곱해 섞음 (계수 선형 보간과 같음)
+    std::vector<float> coefficients;
+    std::vector<float> targetCoefficients;
+    int rampLength = 0;
+    int rampSamplesRemaining = 0;
+
+    std::vector<ChannelState> channels;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WarpedFIRFilter)
+};
@@ -153,6 +153,10 @@ LoudnessCompensatorAudioProcessorEditor::LoudnessCompensatorAudioProcessorEditor
     filterQualitySelector.addItem("Medium (1023)", 2);
     filterQualitySelector.addItem("High (2047)", 3);
     filterQualitySelector.addItem("Ultra (4095)", 4);
+    filterQualitySelector.addItem("Extreme (8191)", 5);
+    filterQualitySelector.addItem("Extreme (16383)", 6);
+    filterQualitySelector.addItem("Extreme (32767)", 7);
+    filterQualitySelector.addItem("Extreme (65535)", 8);
     filterQualitySelector.setSelectedId(4);  // Ultra (4095) 기본값
     filterQualityAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
         audioProcessor.getValueTreeState(), "filterTaps", filterQualitySelector);
@@ -330,6 +334,22 @@ void LoudnessCompensatorAudioProcessorEditor::resized()
 void LoudnessCompensatorAudioProcessorEditor::timerCallback()
 {
     updateLabels();
+    logGovernorEvents();
+}
+
+void LoudnessCompensatorAudioProcessorEditor::logGovernorEvents()
+{
+    // Auto Quality 단계 변경 기록 (DSP의 이벤트 FIFO는 이 타이머에서만 읽음)
+    LoudnessCompensatorDSP::GovernorEvent event;
+    
+    while (audioProcessor.getDSP().readGovernorEvent(event))
+    {
+        const bool downgrade = event.type == LoudnessCompensatorDSP::GovernorEvent::Type::downgrade;
+        
+        juce::Logger::writeToLog(juce::String(downgrade ? "Auto Quality down: " : "Auto Quality up: ")
+                                 + juce::String::formatted("%d -> %d taps (load %.0f%%)",
+                                                           event.fromTaps, event.toTaps, event.load * 100.0f));
+    }
 }
 
 void LoudnessCompensatorAudioProcessorEditor::updateLabels()
@@ -83,6 +83,7 @@ private:
     juce::String formatPhonDisplay(float phon);
     juce::String formatSPLDisplay(float phon);
     void updateExpertControlsState();
+    void logGovernorEvents();
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LoudnessCompensatorAudioProcessorEditor)
 };
\ No newline at end of file
@@ -8,9 +8,44 @@
 
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "DSP/RealtimeSafety.h"
 
 // 프리셋 없음
 
+namespace
+{
+    // 이전 블록 값에서 현재 값으로 블록 전체에 걸쳐 게인 보간
+    void applyGainRamp (juce::AudioBuffer<float>& buffer, float startGain, float endGain)
+    {
+        if (startGain != endGain)
+            buffer.applyGainRamp (0, buffer.getNumSamples(), startGain, endGain);
+        else if (endGain != 1.0f)
+            buffer.applyGain (endGain);
+    }
+
+    // 바이너리 상태: 매직, 형식 버전, 파라미터 ValueTree, (선택) 설계된 IR 계수
+    // 매직이 없으면 이전 버전의 XML 상태로 읽음
+    constexpr int stateMagic = 0x5453434c;  // "LCST"
+    constexpr int stateFormatVersion = 1;
+
+    // Filter Quality 선택 인덱스 (0-7) → 탭 수: Low 511부터 두 배씩, 4-7은 Extreme (8191-65535)
+    int getFilterTapsForChoice (int index)
+    {
+        return (512 << juce::jlimit (0, 7, index)) - 1;
+    }
+    
+    // STFT 프레임 (256-2048), hop = 프레임 / overlap (50%, 75%, 87.5%)
+    int getSpectralFrameSizeForChoice (int index)
+    {
+        return 256 << juce::jlimit (0, 3, index);
+    }
+    
+    int getSpectralHopSizeForChoice (int frameSize, int index)
+    {
+        return frameSize >> (juce::jlimit (0, 2, index) + 1);
+    }
+}
+
 //==============================================================================
 LoudnessCompensatorAudioProcessor::LoudnessCompensatorAudioProcessor()
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -27,27 +62,56 @@ LoudnessCompensatorAudioProcessor::LoudnessCompensatorAudioProcessor()
      : parameters(*this, nullptr, "LoudnessCompensator", createParameterLayout())
 #endif
 {
-    // 파라미터 리스너 설정
+    // 파라미터 값은 여기서 한 번만 찾아 두고 이후에는 원자 변수로 읽음
+    easyLoudnessValue = parameters.getRawParameterValue("easyLoudness");
+    bypassValue = parameters.getRawParameterValue("bypass");
+    kValueValue = parameters.getRawParameterValue("kValue");
+    deltaMaxValue = parameters.getRawParameterValue("deltaMax");
+    filterTapsValue = parameters.getRawParameterValue("filterTaps");
+    expertModeValue = parameters.getRawParameterValue("expertMode");
+    constantLatencyValue = parameters.getRawParameterValue("constantLatency");
+    qualityGovernorValue = parameters.getRawParameterValue("qualityGovernor");
+    responseToleranceValue = parameters.getRawParameterValue("responseTolerance");
+    filterEngineValue = parameters.getRawParameterValue("filterEngine");
+    spectralFrameSizeValue = parameters.getRawParameterValue("spectralFrameSize");
+    spectralOverlapValue = parameters.getRawParameterValue("spectralOverlap");
+    inputGainValue = parameters.getRawParameterValue("inputGain");
+    outputGainValue = parameters.getRawParameterValue("outputGain");
+    
+    publishDSPParameters();
+    startTimerHz(hostUpdateHz);
+    
+    // 파라미터 리스너 설정 (게인은 processBlock에서 블록 내 보간)
+    // easyLoudness는 에디터 표시만 바로 갱신하고, 오디오에는 processBlock에서 하위 블록으로 나눠 적용
     parameters.addParameterListener("easyLoudness", this);
     parameters.addParameterListener("bypass", this);
     parameters.addParameterListener("kValue", this);
     parameters.addParameterListener("deltaMax", this);
     parameters.addParameterListener("filterTaps", this);
     parameters.addParameterListener("expertMode", this);
-    parameters.addParameterListener("inputGain", this);
-    parameters.addParameterListener("outputGain", this);
+    parameters.addParameterListener("constantLatency", this);
+    parameters.addParameterListener("qualityGovernor", this);
+    parameters.addParameterListener("responseTolerance", this);
+    parameters.addParameterListener("filterEngine", this);
+    parameters.addParameterListener("spectralFrameSize", this);
+    parameters.addParameterListener("spectralOverlap", this);
 }
 
 LoudnessCompensatorAudioProcessor::~LoudnessCompensatorAudioProcessor()
 {
+    stopTimer();
     parameters.removeParameterListener("easyLoudness", this);
     parameters.removeParameterListener("bypass", this);
     parameters.removeParameterListener("kValue", this);
     parameters.removeParameterListener("deltaMax", this);
     parameters.removeParameterListener("filterTaps", this);
     parameters.removeParameterListener("expertMode", this);
-    parameters.removeParameterListener("inputGain", this);
-    parameters.removeParameterListener("outputGain", this);
+    parameters.removeParameterListener("constantLatency", this);
+    parameters.removeParameterListener("qualityGovernor", this);
+    parameters.removeParameterListener("responseTolerance", this);
+    parameters.removeParameterListener("filterEngine", this);
+    parameters.removeParameterListener("spectralFrameSize", this);
+    parameters.removeParameterListener("spectralOverlap", this);
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout LoudnessCompensatorAudioProcessor::createParameterLayout()
@@ -93,7 +157,8 @@ juce::AudioProcessorValueTreeState::ParameterLayout LoudnessCompensatorAudioProc
     layout.add(std::make_unique<juce::AudioParameterChoice>(
         "filterTaps",
         "Filter Quality",
-        juce::StringArray{"Low (511)", "Medium (1023)", "High (2047)", "Ultra (4095)"},
+        juce::StringArray{"Low (511)", "Medium (1023)", "High (2047)", "Ultra (4095)",
+                          "Extreme (8191)", "Extreme (16383)", "Extreme (32767)", "Extreme (65535)"},
         3
     ));
     
@@ -104,6 +169,54 @@ juce::AudioProcessorValueTreeState::ParameterLayout LoudnessCompensatorAudioProc
         false
     ));
     
+    // Constant Latency: 품질 변경 시 레이턴시를 바꾸지 않음 (호스트 그래프 재구성 방지)
+    layout.add(std::make_unique<juce::AudioParameterBool>(
+        "constantLatency",
+        "Constant Latency",
+        false
+    ));
+    
+    // Auto Quality: CPU 부하가 높으면 품질을 자동으로 낮췄다가 회복되면 되돌림 (레이턴시는 그대로)
+    layout.add(std::make_unique<juce::AudioParameterBool>(
+        "qualityGovernor",
+        "Auto Quality",
+        false
+    ));
+    
+    // Response Tolerance: 목표 곡선과의 허용 오차 안에서 가장 짧은 필터 사용 (0 = 항상 선택한 품질 길이)
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        "responseTolerance",
+        "Response Tolerance",
+        juce::NormalisableRange<float>(0.0f, 3.0f, 0.05f),
+        0.25f,
+        "dB"
+    ));
+    
+    // Filter Engine: Warped FIR은 수십 탭의 최소 위상 필터 (레이턴시 0, Constant Latency면 지연으로 맞춤)
+    // Hybrid는 저역을 IIR shelf로, 나머지를 짧은 FIR로 처리 (레이턴시 127 샘플)
+    // Spectral은 FIR 설계 없이 STFT bin마다 gain을 곱함 (레이턴시 프레임 - 1 샘플)
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        "filterEngine",
+        "Filter Engine",
+        juce::StringArray{"Linear Phase FIR", "Warped FIR", "Hybrid (IIR + FIR)", "Spectral (STFT)"},
+        0
+    ));
+    
+    // Spectral 엔진 STFT 설정: 프레임이 길수록 저역 해상도가 좋고 레이턴시가 김, overlap이 클수록 hop 경계 잡음이 적고 CPU가 큼
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        "spectralFrameSize",
+        "Spectral Frame",
+        juce::StringArray{"256", "512", "1024", "2048"},
+        2
+    ));
+    
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        "spectralOverlap",
+        "Spectral Overlap",
+        juce::StringArray{"50%", "75%", "87.5%"},
+        1
+    ));
+    
     // Gain parameters
     layout.add(std::make_unique<juce::AudioParameterFloat>(
         "inputGain",
@@ -190,7 +303,15 @@ void LoudnessCompensatorAudioProcessor::changeProgramName (int index, const juce
 //==============================================================================
 void LoudnessCompensatorAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    // DSP 준비
+    // 자동화 보간 시작값
+    lastEasyLoudness = easyLoudnessValue->load();
+    lastInputGain = juce::Decibels::decibelsToGain(inputGainValue->load());
+    lastOutputGain = juce::Decibels::decibelsToGain(outputGainValue->load());
+    
+    // DSP 준비 (오디오 처리가 멈춰 있으므로 밀린 파라미터도 여기서 발행)
+    publishDSPParameters();
+    dsp.setEasyLoudness(lastEasyLoudness);
+    dsp.setNonRealtime(isNonRealtime());
     dsp.prepare(sampleRate, samplesPerBlock);
     
     // 레이턴시 보고
@@ -226,6 +347,8 @@ bool LoudnessCompensatorAudioProcessor::isBusesLayoutSupported (const BusesLayou
 
 void LoudnessCompensatorAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
+    // LOUDNESS_REALTIME_CHECKS 빌드에서 이 블록의 할당/잠금/시스템 호출을 위반으로 보고 (오프라인 렌더링은 제외)
+    const RealtimeSafety::ScopedAudioThread audioThread (!isNonRealtime());
     juce::ScopedNoDenormals noDenormals;
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
@@ -234,24 +357,85 @@ void LoudnessCompensatorAudioProcessor::processBlock (juce::AudioBuffer<float>&
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
 
-    // Input gain 적용
-    float inputGainDB = parameters.getRawParameterValue("inputGain")->load();
-    if (inputGainDB != 0.0f)
+    // 오프라인 렌더링(바운스/내보내기)이면 큰 블록 컨볼루션 경로 사용
+    dsp.setNonRealtime(isNonRealtime());
+
+    // 지난 블록 이후 바뀐 파라미터를 이 블록에 적용 (잠금 없음)
+    publishDSPParameters();
+
+    const float easyLoudness = easyLoudnessValue->load();
+    const float inputGain = juce::Decibels::decibelsToGain(inputGainValue->load());
+    const float outputGain = juce::Decibels::decibelsToGain(outputGainValue->load());
+
+    // 무음 입력으로 꼬리까지 빠졌으면 게인/컨볼루션 모두 생략 (파라미터는 현재 값으로 맞춰 둠)
+    if (dsp.skipIfIdle(buffer))
     {
-        float inputGainLinear = juce::Decibels::decibelsToGain(inputGainDB);
-        buffer.applyGain(inputGainLinear);
+        if (easyLoudness != dsp.getAppliedLoudness())
+            dsp.setEasyLoudness(easyLoudness);
+
+        lastEasyLoudness = easyLoudness;
+        lastInputGain = inputGain;
+        lastOutputGain = outputGain;
+        return;
     }
 
+    // Input gain 적용
+    applyGainRamp(buffer, lastInputGain, inputGain);
+    lastInputGain = inputGain;
+
     // DSP 처리
-    dsp.process(buffer);
+    processLoudnessAutomation(buffer, easyLoudness);
     
     // Output gain 적용
-    float outputGainDB = parameters.getRawParameterValue("outputGain")->load();
-    if (outputGainDB != 0.0f)
+    applyGainRamp(buffer, lastOutputGain, outputGain);
+    lastOutputGain = outputGain;
+}
+
+void LoudnessCompensatorAudioProcessor::processLoudnessAutomation (juce::AudioBuffer<float>& buffer, float targetLoudness)
+{
+    const int numSamples = buffer.getNumSamples();
+    const float delta = targetLoudness - lastEasyLoudness;
+
+    // Loudness가 바뀌었으면 해상도 단위 변화 수만큼 하위 블록으로 나눠 필터 전환을 블록 안에 분산
+    // (상한과 최소 길이로 블록당 전환/부분 FFT 비용을 제한)
+    // 중간값은 이미 설계된 값(추측 설계, 이전 자동화)일 때만 전환하므로 설계는 블록당 마지막 목표값 한 번뿐
+    int numSubBlocks = 1;
+    if (delta != 0.0f)
+    {
+        const int maxSubBlocks = juce::jlimit(1, maxAutomationSubBlocks, numSamples / minAutomationSubBlockSize);
+        numSubBlocks = juce::jlimit(1, maxSubBlocks, static_cast<int>(std::ceil(std::abs(delta) / easyLoudnessResolution)));
+    }
+
+    int start = 0;
+    for (int k = 1; k <= numSubBlocks; ++k)
     {
-        float outputGainLinear = juce::Decibels::decibelsToGain(outputGainDB);
-        buffer.applyGain(outputGainLinear);
+        const int end = numSamples * k / numSubBlocks;
+
+        if (delta != 0.0f)
+        {
+            // 중간값은 파라미터 해상도로 양자화, 마지막 하위 블록은 정확히 목표값
+            float value = targetLoudness;
+            if (k < numSubBlocks)
+                value = std::round((lastEasyLoudness + delta * k / numSubBlocks) / easyLoudnessResolution) * easyLoudnessResolution;
+
+            if (value != dsp.getAppliedLoudness() && (k == numSubBlocks || dsp.isDesignReady(value)))
+                dsp.setEasyLoudness(value);
+        }
+
+        // 채널 포인터만 참조하는 하위 블록 (할당 없음)
+        juce::AudioBuffer<float> subBlock(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), start, end - start);
+        dsp.process(subBlock);
+
+        start = end;
     }
+
+    lastEasyLoudness = targetLoudness;
+}
+
+// 호스트 바이패스도 같은 파라미터를 쓰도록 (레이턴시 정렬 + 크로스페이드 경로)
+juce::AudioProcessorParameter* LoudnessCompensatorAudioProcessor::getBypassParameter() const
+{
+    return parameters.getParameter("bypass");
 }
 
 //==============================================================================
@@ -268,60 +452,173 @@ juce::AudioProcessorEditor* LoudnessCompensatorAudioProcessor::createEditor()
 //==============================================================================
 void LoudnessCompensatorAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    // 파라미터 상태 저장
-    auto state = parameters.copyState();
-    std::unique_ptr<juce::XmlElement> xml (state.createXml());
-    copyXmlToBinary (*xml, destData);
+    juce::MemoryOutputStream stream (destData, false);
+    stream.writeInt (stateMagic);
+    stream.writeInt (stateFormatVersion);
+    
+    // 파라미터 상태 (XML 대신 ValueTree 바이너리)
+    juce::MemoryOutputStream parameterData;
+    parameters.copyState().writeToStream (parameterData);
+    stream.writeInt (static_cast<int> (parameterData.getDataSize()));
+    stream.write (parameterData.getData(), parameterData.getDataSize());
+    
+    // 현재 IR 계수: 복원 시 설계를 건너뛰고 스펙트럼 변환만 하도록
+    auto design = dsp.getCurrentDesign();
+    stream.writeBool (design != nullptr);
+    
+    if (design != nullptr)
+    {
+        stream.writeInt (static_cast<int> (LoudnessCompensatorDSP::designVersion));
+        stream.writeFloat (design->key.targetPhon);
+        stream.writeFloat (design->key.referencePhon);
+        stream.writeInt (design->key.filterTaps);
+        stream.writeDouble (design->key.sampleRate);
+        stream.writeInt (design->key.latencyPadding);
+        stream.writeFloat (design->key.responseTolerance);
+        stream.writeInt (static_cast<int> (design->key.engine));
+        stream.writeFloat (design->preampGain);
+        stream.writeInt (static_cast<int> (design->coefficients.size()));
+        stream.write (design->coefficients.data(), design->coefficients.size() * sizeof (float));
+        stream.writeInt (static_cast<int> (design->iirSections.size()));
+        stream.write (design->iirSections.data(), design->iirSections.size() * sizeof (float));
+    }
 }
 
 void LoudnessCompensatorAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
-    // 파라미터 상태 복원
-    std::unique_ptr<juce::XmlElement> xmlState (getXmlFromBinary (data, sizeInBytes));
+    juce::MemoryInputStream stream (data, static_cast<size_t> (juce::jmax (0, sizeInBytes)), false);
     
-    if (xmlState.get() != nullptr)
-        if (xmlState->hasTagName (parameters.state.getType()))
-            parameters.replaceState (juce::ValueTree::fromXml (*xmlState));
-}
-
-// 파라미터 변경 콜백
-void LoudnessCompensatorAudioProcessor::parameterChanged(const juce::String& parameterID, float newValue)
-{
-    if (parameterID == "easyLoudness")
+    // 이전 버전 세션 (XML)
+    if (sizeInBytes < 8 || stream.readInt() != stateMagic)
     {
-        dsp.setEasyLoudness(newValue);
+        std::unique_ptr<juce::XmlElement> xmlState (getXmlFromBinary (data, sizeInBytes));
+        
+        if (xmlState.get() != nullptr)
+            replaceParameterState (juce::ValueTree::fromXml (*xmlState));
+        
+        return;
     }
-    else if (parameterID == "bypass")
-    {
-        dsp.setBypass(newValue > 0.5f);
-    }
-    else if (parameterID == "kValue")
-    {
-        dsp.setKValue(newValue);
-    }
-    else if (parameterID == "deltaMax")
-    {
-        dsp.setDeltaMax(newValue);
-    }
-    else if (parameterID == "filterTaps")
+    
+    // 더 새 형식은 읽지 않음
+    if (stream.readInt() > stateFormatVersion)
+        return;
+    
+    const int parameterSize = stream.readInt();
+    if (parameterSize <= 0 || parameterSize > stream.getNumBytesRemaining())
+        return;
+    
+    juce::MemoryBlock parameterData;
+    stream.readIntoMemoryBlock (parameterData, parameterSize);
+    
+    // 저장된 IR은 설계 버전이 같을 때만 사용 (샘플레이트나 파라미터가 다르면 키가 달라 재설계됨)
+    // 파라미터보다 먼저 등록해야 복원 후 첫 설계가 이 계수를 찾음
+    if (stream.readBool() && stream.readInt() == static_cast<int> (LoudnessCompensatorDSP::designVersion))
     {
-        int taps = 511;
-        int index = static_cast<int>(newValue * 3.0f + 0.5f);
-        switch (index)
+        FilterDesignKey key;
+        key.targetPhon = stream.readFloat();
+        key.referencePhon = stream.readFloat();
+        key.filterTaps = stream.readInt();
+        key.sampleRate = stream.readDouble();
+        key.latencyPadding = stream.readInt();
+        key.responseTolerance = stream.readFloat();
+        key.engine = static_cast<FilterEngine> (juce::jlimit (0, static_cast<int> (FilterEngine::hybrid), stream.readInt()));
+        
+        const float preampGain = stream.readFloat();
+        const int numCoefficients = stream.readInt();
+        
+        if (numCoefficients > 0 && numCoefficients <= LoudnessCompensatorDSP::maxExtremeFilterTaps
+            && stream.getNumBytesRemaining() >= static_cast<juce::int64> (numCoefficients * sizeof (float)))
         {
-            case 0: taps = 511; break;
-            case 1: taps = 1023; break;
-            case 2: taps = 2047; break;
-            case 3: taps = 4095; break;
+            std::vector<float> coefficients (static_cast<size_t> (numCoefficients));
+            stream.read (coefficients.data(), numCoefficients * static_cast<int> (sizeof (float)));
+            
+            // hybrid 엔진의 IIR 단 (나머지 엔진은 0개)
+            const int numSections = stream.readInt();
+            std::vector<float> iirSections;
+            
+            if (numSections > 0 && numSections <= BiquadCascade::numLowShelves * BiquadCascade::coefficientsPerSection
+                && stream.getNumBytesRemaining() >= static_cast<juce::int64> (numSections * sizeof (float)))
+            {
+                iirSections.resize (static_cast<size_t> (numSections));
+                stream.read (iirSections.data(), numSections * static_cast<int> (sizeof (float)));
+            }
+            
+            dsp.restoreDesign (key, std::move (coefficients), preampGain, std::move (iirSections));
         }
-        dsp.setFilterTaps(taps);
     }
-    else if (parameterID == "expertMode")
+    
+    replaceParameterState (juce::ValueTree::readFromData (parameterData.getData(), parameterData.getSize()));
+}
+
+void LoudnessCompensatorAudioProcessor::replaceParameterState (const juce::ValueTree& state)
+{
+    // 리스너가 여러 번 불려도 필터 설계는 복원 후 한 번
+    if (state.hasType (parameters.state.getType()))
     {
-        dsp.setExpertMode(newValue > 0.5f);
+        const LoudnessCompensatorDSP::ScopedParameterBatch batch (dsp);
+        parameters.replaceState (state);
     }
 }
 
+// 파라미터 변경 콜백 (어느 스레드에서든 불릴 수 있음)
+// VST3/AU 자동화는 오디오 스레드에서 부르므로 세대만 올리고, 발행은 processBlock, 호스트 알림은 타이머가 맡음
+// 에디터 표시값은 원자 변수로 바로 갱신 (트랜스포트가 멈춰 processBlock이 불리지 않아도 표시가 따라감)
+void LoudnessCompensatorAudioProcessor::parameterChanged(const juce::String& parameterID, float)
+{
+    // Loudness는 processBlock이 블록마다 직접 읽으므로 묶음을 다시 발행할 필요 없음
+    if (parameterID != "easyLoudness")
+        parameterGeneration.fetch_add(1);
+    
+    dsp.publishDisplayValues(easyLoudnessValue->load(), makeDSPParameters());
+}
+
+void LoudnessCompensatorAudioProcessor::timerCallback()
+{
+    // Extreme 단계를 새로 골랐으면 버퍼를 늘림 (그때까지 DSP는 이전 파라미터로 처리)
+    if (dsp.needsFilterCapacity())
+    {
+        // suspendProcessing은 콜백 잠금을 잡으므로 돌아오면 processBlock이 돌고 있지 않음
+        const bool wasSuspended = isSuspended();
+        suspendProcessing (true);
+        dsp.growFilterCapacity();
+        suspendProcessing (wasSuspended);
+    }
+    
+    // 품질/고정 레이턴시/엔진 변경으로 레이턴시가 바뀌었으면 호스트에 다시 보고
+    if (dsp.getLatencySamples() != getLatencySamples())
+        setLatencySamples(dsp.getLatencySamples());
+}
+
+void LoudnessCompensatorAudioProcessor::publishDSPParameters()
+{
+    // 오디오 스레드(또는 처리가 멈춘 동안)에서만 부름: 세대가 바뀌었을 때만 원자 변수에서 읽어 발행
+    const auto generation = parameterGeneration.load();
+    if (generation == publishedParameterGeneration)
+        return;
+    
+    publishedParameterGeneration = generation;
+    dsp.setParametersFromAudioThread(makeDSPParameters());
+}
+
+LoudnessCompensatorDSP::Parameters LoudnessCompensatorAudioProcessor::makeDSPParameters() const
+{
+    LoudnessCompensatorDSP::Parameters dspParameters;
+    dspParameters.bypass = bypassValue->load() > 0.5f;
+    dspParameters.kValue = kValueValue->load();
+    dspParameters.deltaMax = deltaMaxValue->load();
+    dspParameters.filterTaps = getFilterTapsForChoice(juce::roundToInt(filterTapsValue->load()));
+    dspParameters.expertMode = expertModeValue->load() > 0.5f;
+    dspParameters.constantLatency = constantLatencyValue->load() > 0.5f;
+    dspParameters.qualityGovernor = qualityGovernorValue->load() > 0.5f;
+    dspParameters.responseTolerance = responseToleranceValue->load();
+    dspParameters.engine = static_cast<LoudnessCompensatorDSP::FilterEngine>(
+        juce::jlimit(0, static_cast<int>(LoudnessCompensatorDSP::FilterEngine::spectral), juce::roundToInt(filterEngineValue->load())));
+    dspParameters.spectralFrameSize = getSpectralFrameSizeForChoice(juce::roundToInt(spectralFrameSizeValue->load()));
+    dspParameters.spectralHopSize = getSpectralHopSizeForChoice(dspParameters.spectralFrameSize, juce::roundToInt(spectralOverlapValue->load()));
+    
+    return dspParameters;
+}
+
 //==============================================================================
 // This creates new instances of the plugin..
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
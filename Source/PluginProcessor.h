@@ -16,7 +16,8 @@
 /**
 */
 class LoudnessCompensatorAudioProcessor  : public juce::AudioProcessor,
-                                          public juce::AudioProcessorValueTreeState::Listener
+                                          public juce::AudioProcessorValueTreeState::Listener,
+                                          private juce::Timer
                             #if JucePlugin_Enable_ARA
                              , public juce::AudioProcessorARAExtension
                             #endif
@@ -35,6 +36,7 @@ public:
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    juce::AudioProcessorParameter* getBypassParameter() const override;
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -76,6 +78,48 @@ private:
     juce::AudioProcessorValueTreeState parameters;
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     
+    // 미리 찾아 둔 파라미터 값 (APVTS 소유)
+    std::atomic<float>* easyLoudnessValue = nullptr;
+    std::atomic<float>* bypassValue = nullptr;
+    std::atomic<float>* kValueValue = nullptr;
+    std::atomic<float>* deltaMaxValue = nullptr;
+    std::atomic<float>* filterTapsValue = nullptr;
+    std::atomic<float>* expertModeValue = nullptr;
+    std::atomic<float>* constantLatencyValue = nullptr;
+    std::atomic<float>* qualityGovernorValue = nullptr;
+    std::atomic<float>* responseToleranceValue = nullptr;
+    std::atomic<float>* filterEngineValue = nullptr;
+    std::atomic<float>* spectralFrameSizeValue = nullptr;
+    std::atomic<float>* spectralOverlapValue = nullptr;
+    std::atomic<float>* inputGainValue = nullptr;
+    std::atomic<float>* outputGainValue = nullptr;
+    
+    // 파라미터 변경 세대: parameterChanged는 어느 스레드에서든 올리기만 하고 (잠금/메시지 없음)
+    // 오디오 스레드가 블록 시작에 현재 값 전체를 DSP에 한 묶음으로 발행
+    std::atomic<juce::uint32> parameterGeneration { 1 };
+    juce::uint32 publishedParameterGeneration = 0;
+    void publishDSPParameters();
+    LoudnessCompensatorDSP::Parameters makeDSPParameters() const;  // 원자 변수만 읽음 (어느 스레드에서든)
+    
+    // 메시지 스레드: Extreme 단계 버퍼를 오디오 처리를 잠시 멈추고 늘리고, 바뀐 레이턴시를 호스트에 보고
+    void timerCallback() override;
+    static constexpr int hostUpdateHz = 20;
+    
+    // 세션 복원 (XML/바이너리 공통)
+    void replaceParameterState (const juce::ValueTree& state);
+    
+    // 블록 내 자동화 보간
+    // JUCE는 호스트의 블록 내 변경 시점을 넘겨주지 않으므로 이전 블록 값에서 현재 값까지 블록 전체에 걸쳐 보간
+    void processLoudnessAutomation (juce::AudioBuffer<float>& buffer, float targetLoudness);
+    
+    float lastEasyLoudness = 55.0f;
+    float lastInputGain = 1.0f;
+    float lastOutputGain = 1.0f;
+    
+    static constexpr int maxAutomationSubBlocks = 8;       // 블록당 필터 전환 상한
+    static constexpr int minAutomationSubBlockSize = 64;
+    static constexpr float easyLoudnessResolution = 0.1f;  // 파라미터 해상도 (중간값 설계를 재사용하도록 양자화)
+    
     // 파라미터 리스너
     std::unique_ptr<juce::AudioProcessorValueTreeState::Listener> easyLoudnessListener;
     std::unique_ptr<juce::AudioProcessorValueTreeState::Listener> bypassListener;
@@ -0,0 +1,120 @@
+/*
+  ==============================================================================
+
+    CoefficientRampTests.cpp
+    필터 교체 시 파티션 계수 램프: 클릭 없음, 블록 에너지가 이전/새 수준 사이로 이어짐
+
+  ==============================================================================
+*/
+
+#include "TestHelpers.h"
+
+class CoefficientRampTests : public juce::UnitTest
+{
+public:
+    CoefficientRampTests() : juce::UnitTest("Coefficient ramp", "LoudnessCompensator") {}
+
+    void runTest() override
+    {
+        const auto hard = measureSwitch(0);
+        const auto ramped = measureSwitch(8);
+
+        beginTest("Ramped filter change has no click");
+        logMessage("max second difference: steady " + juce::String(ramped.steadyStep, 6)
+                   + ", hard swap " + juce::String(hard.switchStep, 6)
+                   + ", 8-block ramp " + juce::String(ramped.switchStep, 6));
+
+        // 램프는 계수를 블록 경계마다 1/rampBlocks씩 옮기므로 경계의 불연속도 그만큼 작아야 함
+        expect(ramped.ready && hard.ready, "first design did not finish");
+        expectGreaterThan(hard.switchStep, ramped.steadyStep * 100.0f, "hard swap should click on this signal");
+        expectLessThan(ramped.switchStep, hard.switchStep * 0.25f, "ramp does not soften the switch");
+
+        beginTest("Ramped filter change keeps block energy between the old and new levels");
+        const float low = juce::jmin(ramped.rmsBefore, ramped.rmsAfter);
+        const float high = juce::jmax(ramped.rmsBefore, ramped.rmsAfter);
+        expectGreaterThan(std::abs(ramped.rmsAfter - ramped.rmsBefore), high * 0.1f, "loudness change too small to test");
+
+        for (size_t i = 0; i < ramped.transitionRMS.size(); ++i)
+        {
+            const float rms = ramped.transitionRMS[i];
+            expect(rms >= low * 0.95f && rms <= high * 1.05f,
+                   "block " + juce::String(static_cast<int>(i)) + " RMS " + juce::String(rms, 4)
+                   + " outside " + juce::String(low, 4) + " .. " + juce::String(high, 4));
+        }
+
+        // 에너지 구멍 없이 한 방향으로 움직여야 함
+        // (IR 램프와 preamp 스무딩이 곱해져 중간에 조금 넘칠 수 있으므로 작은 되돌림은 허용)
+        const float direction = ramped.rmsAfter > ramped.rmsBefore ? 1.0f : -1.0f;
+        for (size_t i = 1; i < ramped.transitionRMS.size(); ++i)
+            expectGreaterOrEqual(direction * (ramped.transitionRMS[i] - ramped.transitionRMS[i - 1]), -high * 0.02f,
+                                 "block energy reverses during the ramp");
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 256;
+    static constexpr int settleBlocks = 200;
+    static constexpr int transitionBlocks = 16;
+
+    struct SwitchMeasurement
+    {
+        bool ready = false;
+        float steadyStep = 0.0f;  // 전환 전 같은 길이 구간의 2차 차분 최댓값
+        float switchStep = 0.0f;  // 전환 블록부터 transitionBlocks 동안
+        float rmsBefore = 0.0f;
+        float rmsAfter = 0.0f;
+        std::vector<float> transitionRMS;
+    };
+
+    // 저역 사인파를 흘리며 Loudness를 40 → 70으로 바꿈 (같은 탭 수라 레이턴시가 같아 램프 대상)
+    SwitchMeasurement measureSwitch(int rampBlocks)
+    {
+        SwitchMeasurement result;
+
+        LoudnessCompensatorDSP dsp;
+        dsp.setProgressiveDesign(false);
+        dsp.setFilterRampBlocks(rampBlocks);
+        dsp.setFilterTaps(1023);
+        dsp.setEasyLoudness(40.0f);
+        dsp.prepare(sampleRate, blockSize);
+
+        result.ready = TestHelpers::waitForFilter(dsp, blockSize);
+
+        TestHelpers::SineSource source;
+        source.sampleRate = sampleRate;
+
+        const int numBlocks = 2 * settleBlocks;
+        std::vector<float> output;
+        output.reserve(static_cast<size_t>(numBlocks * blockSize));
+        juce::AudioBuffer<float> buffer(2, blockSize);
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            if (block == settleBlocks)
+                dsp.setEasyLoudness(70.0f);
+
+            source.fill(buffer);
+            dsp.process(buffer);
+            output.insert(output.end(), buffer.getReadPointer(0), buffer.getReadPointer(0) + blockSize);
+        }
+
+        const int switchStart = settleBlocks * blockSize;
+        const int windowLength = transitionBlocks * blockSize;
+        const auto* samples = output.data();
+
+        // 사인파 주기의 정수배 창으로 에너지를 재야 위상에 따라 흔들리지 않음
+        const int rmsWindow = juce::roundToInt(4.0 * sampleRate / source.frequency);
+
+        result.steadyStep = TestHelpers::getMaxSecondDifference(samples + switchStart - windowLength, windowLength);
+        result.switchStep = TestHelpers::getMaxSecondDifference(samples + switchStart - 1, windowLength + 2);
+        result.rmsBefore = TestHelpers::getRMS(samples + switchStart - rmsWindow, rmsWindow);
+        result.rmsAfter = TestHelpers::getRMS(samples + numBlocks * blockSize - rmsWindow, rmsWindow);
+
+        for (int start = switchStart - rmsWindow / 2; start < switchStart + windowLength; start += blockSize)
+            result.transitionRMS.push_back(TestHelpers::getRMS(samples + start, rmsWindow));
+
+        return result;
+    }
+};
+
+static CoefficientRampTests coefficientRampTests;
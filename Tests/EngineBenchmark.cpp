@@ -0,0 +1,240 @@
+/*
+  ==============================================================================
+
+    EngineBenchmark.cpp
+    필터 엔진별 목표 곡선 오차, 아티팩트, CPU를 컨볼루션 경로(Ultra)와 비교
+
+  ==============================================================================
+*/
+
+#include "TestHelpers.h"
+#include "DSP/ISO226Data.h"
+#include <functional>
+
+class EngineBenchmark : public juce::UnitTest
+{
+public:
+    EngineBenchmark() : juce::UnitTest("Filter engines against the convolution path", "Benchmarks") {}
+
+    void runTest() override
+    {
+        const auto ultra = measureEngine("Ultra (4095)", [](LoudnessCompensatorDSP& dsp)
+        {
+            dsp.setFilterTaps(4095);
+            dsp.setResponseTolerance(0.0f);
+        });
+
+        beginTest("Warped FIR");
+        {
+            const auto warped = measureEngine("Warped (48)", [](LoudnessCompensatorDSP& dsp)
+            {
+                dsp.setFilterEngine(LoudnessCompensatorDSP::FilterEngine::warped);
+            });
+
+            // 수십 탭으로 저역까지 Ultra 이상의 정확도, 선형 시불변이므로 아티팩트 없음
+            for (size_t i = 0; i < loudnessLevels.size(); ++i)
+            {
+                expectLessOrEqual(warped.maxErrorDB[i], ultra.maxErrorDB[i], "less accurate than Ultra");
+                expectLessThan(warped.artefactDB[i], -80.0f, "artefacts on a pure sine");
+            }
+        }
+
+        beginTest("Hybrid IIR shelves + 255-tap FIR");
+        {
+            const auto hybrid = measureEngine("Hybrid (4 shelves + 255)", [](LoudnessCompensatorDSP& dsp)
+            {
+                dsp.setFilterEngine(LoudnessCompensatorDSP::FilterEngine::hybrid);
+            });
+
+            // 저역은 shelf 단이 맡으므로 짧은 FIR로도 Ultra 이상의 정확도
+            for (size_t i = 0; i < loudnessLevels.size(); ++i)
+            {
+                expectLessOrEqual(hybrid.maxErrorDB[i], ultra.maxErrorDB[i], "less accurate than Ultra");
+                expectLessThan(hybrid.artefactDB[i], -80.0f, "artefacts on a pure sine");
+            }
+
+            logMessage("hybrid CPU " + juce::String(100.0 * hybrid.microsecondsPerBlock / ultra.microsecondsPerBlock, 0) + " % of Ultra");
+        }
+
+        beginTest("Spectral STFT gains");
+        {
+            // 기본 설정 (1024 / 75%)과 가장 긴 프레임
+            for (const int frameSize : { 1024, 2048 })
+            {
+                const int hopSize = frameSize / 4;
+                const auto spectral = measureEngine("Spectral (" + juce::String(frameSize) + " / 75%)",
+                                                    [frameSize, hopSize](LoudnessCompensatorDSP& dsp)
+                {
+                    dsp.setFilterEngine(LoudnessCompensatorDSP::FilterEngine::spectral);
+                    dsp.setSpectralFrameSize(frameSize, hopSize);
+                });
+
+                // bin gain을 곡선에서 바로 읽으므로 Ultra 이상의 정확도
+                // 프레임 간격마다 gain이 곱해지는 시변 처리라 hop 주기의 측대역이 남음 (곡선이 가파른 20 phon이 최악)
+                for (size_t i = 0; i < loudnessLevels.size(); ++i)
+                {
+                    expectLessOrEqual(spectral.maxErrorDB[i], ultra.maxErrorDB[i], "less accurate than Ultra");
+                    expectLessThan(spectral.artefactDB[i], -40.0f, "time-aliasing sidebands above the expected level");
+                }
+
+                logMessage("spectral CPU " + juce::String(100.0 * spectral.microsecondsPerBlock / ultra.microsecondsPerBlock, 0) + " % of Ultra");
+            }
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 128;
+    static constexpr int settleSamples = 16384;  // Ultra 레이턴시, warped 저역 군지연보다 충분히 길게
+    static constexpr int fitSamples = 16384;
+    static constexpr int cpuBlocks = 4000;
+    static constexpr float sineAmplitude = 0.01f;  // 저역 gain이 커도 출력이 크게 넘치지 않도록
+    static constexpr std::array<float, 3> loudnessLevels { 20.0f, 40.0f, 60.0f };
+
+    struct EngineMeasurement
+    {
+        std::array<float, loudnessLevels.size()> maxErrorDB {};   // ISO 목표 곡선 대비 최대 오차 (1 kHz 정규화)
+        std::array<float, loudnessLevels.size()> artefactDB {};   // 사인 잔차 / 사인 (최악 주파수)
+        double microsecondsPerBlock = 0.0;
+    };
+
+    struct SineFit
+    {
+        double amplitude = 0.0;
+        double residualRMS = 0.0;
+    };
+
+    // 알려진 주파수의 사인을 최소제곱으로 맞추고 나머지(왜곡, 시변 측대역)를 잼
+    static SineFit fitSine(const std::vector<float>& samples, double frequency, juce::int64 firstIndex)
+    {
+        const double omega = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+        double ss = 0.0, sc = 0.0, cc = 0.0, xs = 0.0, xc = 0.0;
+
+        for (size_t n = 0; n < samples.size(); ++n)
+        {
+            const double phase = omega * static_cast<double>(firstIndex + static_cast<juce::int64>(n));
+            const double s = std::sin(phase), c = std::cos(phase), x = samples[n];
+            ss += s * s; sc += s * c; cc += c * c; xs += x * s; xc += x * c;
+        }
+
+        const double determinant = ss * cc - sc * sc;
+        const double a = (xs * cc - xc * sc) / determinant;
+        const double b = (xc * ss - xs * sc) / determinant;
+
+        double residual = 0.0;
+        for (size_t n = 0; n < samples.size(); ++n)
+        {
+            const double phase = omega * static_cast<double>(firstIndex + static_cast<juce::int64>(n));
+            const double e = samples[n] - a * std::sin(phase) - b * std::cos(phase);
+            residual += e * e;
+        }
+
+        return { std::sqrt(a * a + b * b), std::sqrt(residual / static_cast<double>(samples.size())) };
+    }
+
+    static std::unique_ptr<LoudnessCompensatorDSP> createEngine(const std::function<void(LoudnessCompensatorDSP&)>& configure,
+                                                                float loudness)
+    {
+        auto dsp = std::make_unique<LoudnessCompensatorDSP>();
+        dsp->setProgressiveDesign(false);  // 미리듣기 필터가 아니라 전체 설계를 잼
+        configure(*dsp);
+        dsp->setEasyLoudness(loudness);
+        dsp->prepare(sampleRate, blockSize);
+        return dsp;
+    }
+
+    EngineMeasurement measureEngine(const juce::String& name, const std::function<void(LoudnessCompensatorDSP&)>& configure)
+    {
+        EngineMeasurement result;
+        juce::AudioBuffer<float> buffer(2, blockSize);
+
+        for (size_t level = 0; level < loudnessLevels.size(); ++level)
+        {
+            auto dsp = createEngine(configure, loudnessLevels[level]);
+            expect(TestHelpers::waitForFilter(*dsp, blockSize), name + ": first design did not finish");
+
+            // ISO 주파수마다 정상 상태 사인의 gain을 재고, 1 kHz 기준으로 목표 곡선과 비교
+            std::array<double, ISO226::NUM_FREQUENCIES> gainsDB {};
+            float worstArtefact = -200.0f;
+
+            for (int i = 0; i < ISO226::NUM_FREQUENCIES; ++i)
+            {
+                TestHelpers::SineSource source;
+                source.frequency = ISO226::FREQUENCIES[i];
+                source.sampleRate = sampleRate;
+                source.amplitude = sineAmplitude;
+
+                std::vector<float> output;
+                output.reserve(static_cast<size_t>(fitSamples));
+
+                while (source.position < settleSamples + fitSamples)
+                {
+                    const bool settled = source.position >= settleSamples;
+                    source.fill(buffer);
+                    dsp->process(buffer);
+
+                    if (settled)
+                        output.insert(output.end(), buffer.getReadPointer(0), buffer.getReadPointer(0) + blockSize);
+                }
+
+                const auto fit = fitSine(output, source.frequency, settleSamples);
+                gainsDB[static_cast<size_t>(i)] = juce::Decibels::gainToDecibels(fit.amplitude / sineAmplitude, -200.0);
+                worstArtefact = juce::jmax(worstArtefact,
+                                           static_cast<float>(juce::Decibels::gainToDecibels(fit.residualRMS * std::sqrt(2.0) / fit.amplitude, -200.0)));
+            }
+
+            const auto target = dsp->getTargetGains();
+            const auto reference = gainsDB[static_cast<size_t>(ISO226::get1kHzIndex())];
+            float maxError = 0.0f;
+
+            for (size_t i = 0; i < gainsDB.size(); ++i)
+                maxError = juce::jmax(maxError, static_cast<float>(std::abs(gainsDB[i] - reference - target[i])));
+
+            result.maxErrorDB[level] = maxError;
+            result.artefactDB[level] = worstArtefact;
+        }
+
+        result.microsecondsPerBlock = measureCPU(configure);
+
+        juce::String errors, artefacts;
+        for (size_t level = 0; level < loudnessLevels.size(); ++level)
+        {
+            const auto separator = level > 0 ? " / " : "";
+            errors << separator << juce::String(result.maxErrorDB[level], 2);
+            artefacts << separator << juce::String(result.artefactDB[level], 1);
+        }
+
+        logMessage(name + ": max error " + errors + " dB, artefacts " + artefacts + " dB at 20 / 40 / 60 phon, "
+                   + juce::String(result.microsecondsPerBlock, 1) + " us per " + juce::String(blockSize) + " stereo samples");
+        return result;
+    }
+
+    // 스테레오 잡음을 처리하는 데 걸리는 블록당 시간 (40 phon)
+    double measureCPU(const std::function<void(LoudnessCompensatorDSP&)>& configure)
+    {
+        auto dsp = createEngine(configure, 40.0f);
+        TestHelpers::waitForFilter(*dsp, blockSize);
+
+        juce::Random random(1);
+        juce::AudioBuffer<float> input(2, blockSize), buffer(2, blockSize);
+        for (int ch = 0; ch < input.getNumChannels(); ++ch)
+            for (int i = 0; i < blockSize; ++i)
+                input.setSample(ch, i, 0.1f * (random.nextFloat() * 2.0f - 1.0f));
+
+        double elapsed = 0.0;
+        for (int block = -50; block < cpuBlocks; ++block)
+        {
+            buffer.makeCopyOf(input, true);
+
+            const auto start = juce::Time::getMillisecondCounterHiRes();
+            dsp->process(buffer);
+
+            if (block >= 0)
+                elapsed += juce::Time::getMillisecondCounterHiRes() - start;
+        }
+
+        return elapsed * 1000.0 / cpuBlocks;
+    }
+};
+
+static EngineBenchmark engineBenchmark;
@@ -0,0 +1,111 @@
+/*
+  ==============================================================================
+
+    LoudnessAutomationTests.cpp
+    블록 내 Loudness 자동화: 호스트 블록당 필터 설계는 최대 한 번
+    처리가 멈춘 동안에도 에디터 표시값은 파라미터를 따라감
+
+  ==============================================================================
+*/
+
+#include "TestHelpers.h"
+#include "PluginProcessor.h"
+
+class LoudnessAutomationTests : public juce::UnitTest
+{
+public:
+    LoudnessAutomationTests() : juce::UnitTest("Loudness automation", "LoudnessCompensator") {}
+
+    void runTest() override
+    {
+        beginTest("Only designed values split a host block");
+        {
+            LoudnessCompensatorDSP dsp;
+            dsp.setEasyLoudness(50.0f);
+            dsp.prepare(sampleRate, blockSize);
+            expect(TestHelpers::waitForFilter(dsp, blockSize), "first design did not finish");
+
+            expect(dsp.isDesignReady(50.0f), "applied design is not reported as ready");
+            expect(dsp.isDesignReady(50.02f), "value is not quantised like setEasyLoudness");
+            expect(!dsp.isDesignReady(33.3f), "value that was never designed is reported as ready");
+        }
+
+        beginTest("A host block runs at most one filter design");
+        {
+            LoudnessCompensatorAudioProcessor processor;
+            processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+            processor.prepareToPlay(sampleRate, blockSize);
+
+            auto& dsp = processor.getDSP();
+            auto* loudness = processor.getValueTreeState().getParameter("easyLoudness");
+            expect(loudness != nullptr);
+
+            juce::AudioBuffer<float> buffer(2, blockSize);
+            juce::MidiBuffer midi;
+            TestHelpers::SineSource source;
+            source.sampleRate = sampleRate;
+
+            // 첫 설계(작업 스레드)가 끝날 때까지
+            const auto deadline = juce::Time::getMillisecondCounterHiRes() + 30000.0;
+            while (!dsp.isFilterReady() && juce::Time::getMillisecondCounterHiRes() < deadline)
+            {
+                source.fill(buffer);
+                processor.processBlock(buffer, midi);
+                juce::Thread::sleep(1);
+            }
+
+            expect(dsp.isFilterReady(), "first design did not finish");
+
+            // 블록마다 1.5 phon씩 (15개 해상도 단계 → 하위 블록 상한 8개까지 나눌 수 있는 변화)
+            juce::int64 maxDesignsPerBlock = 0;
+            float value = 30.0f;
+
+            for (int block = 0; block < numAutomationBlocks && loudness != nullptr; ++block)
+            {
+                value += 1.5f;
+                loudness->setValueNotifyingHost(loudness->convertTo0to1(value));
+
+                const auto missesBefore = dsp.getSpeculationStats().misses;
+                source.fill(buffer);
+                processor.processBlock(buffer, midi);
+
+                maxDesignsPerBlock = juce::jmax(maxDesignsPerBlock, dsp.getSpeculationStats().misses - missesBefore);
+            }
+
+            expectLessOrEqual(maxDesignsPerBlock, static_cast<juce::int64>(1), "a host block ran more than one design");
+            expectWithinAbsoluteError(dsp.getTargetPhon(), value, 0.05f, "automation did not reach the target");
+
+            processor.releaseResources();
+        }
+
+        beginTest("Editor readouts follow Loudness while no blocks are processed");
+        {
+            LoudnessCompensatorAudioProcessor processor;
+            processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+            processor.prepareToPlay(sampleRate, blockSize);
+
+            auto& dsp = processor.getDSP();
+            auto* loudness = processor.getValueTreeState().getParameter("easyLoudness");
+            expect(loudness != nullptr);
+
+            // 트랜스포트가 멈춘 호스트처럼 processBlock 없이 값만 바꿈
+            for (const float value : { 35.0f, 62.5f })
+            {
+                if (loudness != nullptr)
+                    loudness->setValueNotifyingHost(loudness->convertTo0to1(value));
+
+                expectWithinAbsoluteError(dsp.getTargetPhon(), value, 0.05f, "target phon readout is stale");
+                expect(dsp.getReferencePhon() > dsp.getTargetPhon(), "reference phon readout is not above the target");
+            }
+
+            processor.releaseResources();
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 2048;
+    static constexpr int numAutomationBlocks = 20;
+};
+
+static LoudnessAutomationTests loudnessAutomationTests;
@@ -0,0 +1,152 @@
+/*
+  ==============================================================================
+
+    PathSwitchTests.cpp
+    경로 전환(바이패스 해제, 엔진 변경): 새 경로를 여러 블록에 나눠 채우고, 클릭 없이 이어지며,
+    채운 뒤에는 전환하지 않은 인스턴스와 같은 출력
+
+  ==============================================================================
+*/
+
+#include "TestHelpers.h"
+
+class PathSwitchTests : public juce::UnitTest
+{
+public:
+    PathSwitchTests() : juce::UnitTest("Path switch", "LoudnessCompensator") {}
+
+    void runTest() override
+    {
+        beginTest("Bypass release primes over several blocks and rejoins the unbypassed output");
+        {
+            const auto result = measureSwitch([](LoudnessCompensatorDSP& dsp, int block)
+            {
+                if (block == bypassBlock)
+                    dsp.setBypass(true);
+                else if (block == switchBlock)
+                    dsp.setBypass(false);
+            }, FilterEngine::linearPhase);
+
+            expectSwitch(result);
+        }
+
+        beginTest("Engine switch fades out, primes the new engine and rejoins its output");
+        {
+            const auto result = measureSwitch([](LoudnessCompensatorDSP& dsp, int block)
+            {
+                if (block == switchBlock)
+                    dsp.setFilterEngine(FilterEngine::hybrid);
+            }, FilterEngine::hybrid);
+
+            expectSwitch(result);
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 256;
+    static constexpr int bypassBlock = 100;
+    static constexpr int switchBlock = 200;
+    static constexpr int numBlocks = 300;
+
+    struct SwitchMeasurement
+    {
+        bool ready = false;
+        int dryBlocks = 0;            // 기준 출력과 같아지기 전 원신호만 나간 블록 수 (채우는 중)
+        int firstMatchingBlock = -1;  // 전환 뒤 처음으로 기준 출력과 같아진 블록
+        float steadyStep = 0.0f;
+        float switchStep = 0.0f;
+    };
+
+    // 같은 사인파를 세 인스턴스에 흘림: 전환하는 쪽, 처음부터 전환 뒤 설정인 기준, 계속 바이패스인 원신호
+    // 엔진마다 레이턴시가 같도록 고정 레이턴시 모드
+    template <typename SwitchFunction>
+    SwitchMeasurement measureSwitch(SwitchFunction&& applySwitch, FilterEngine targetEngine)
+    {
+        SwitchMeasurement result;
+
+        LoudnessCompensatorDSP switching, target, dry;
+        switching.setFilterEngine(FilterEngine::linearPhase);
+        target.setFilterEngine(targetEngine);
+        dry.setBypass(true);
+
+        for (auto* dsp : { &switching, &target, &dry })
+        {
+            dsp->setProgressiveDesign(false);
+            dsp->setConstantLatency(true);
+            dsp->setFilterTaps(1023);
+            dsp->setEasyLoudness(40.0f);
+            dsp->prepare(sampleRate, blockSize);
+        }
+
+        result.ready = TestHelpers::waitForFilter(switching, blockSize) && TestHelpers::waitForFilter(target, blockSize);
+
+        TestHelpers::SineSource source;
+        source.sampleRate = sampleRate;
+
+        std::vector<float> output;
+        output.reserve(static_cast<size_t>(numBlocks * blockSize));
+        juce::AudioBuffer<float> input(2, blockSize), buffer(2, blockSize), targetBuffer(2, blockSize), dryBuffer(2, blockSize);
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            applySwitch(switching, block);
+
+            source.fill(input);
+            buffer.makeCopyOf(input, true);
+            targetBuffer.makeCopyOf(input, true);
+            dryBuffer.makeCopyOf(input, true);
+            switching.process(buffer);
+            target.process(targetBuffer);
+            dry.process(dryBuffer);
+
+            output.insert(output.end(), buffer.getReadPointer(0), buffer.getReadPointer(0) + blockSize);
+
+            if (block <= switchBlock)
+                continue;
+
+            if (result.firstMatchingBlock < 0 && getMaxDifference(buffer, targetBuffer) < 1.0e-4f)
+                result.firstMatchingBlock = block - switchBlock;
+
+            if (result.firstMatchingBlock < 0 && getMaxDifference(buffer, dryBuffer) == 0.0f)
+                ++result.dryBlocks;
+        }
+
+        const int switchStart = switchBlock * blockSize;
+        const int windowLength = (numBlocks - switchBlock) * blockSize;
+        result.steadyStep = TestHelpers::getMaxSecondDifference(output.data() + switchStart - windowLength / 2, windowLength / 2);
+        result.switchStep = TestHelpers::getMaxSecondDifference(output.data() + switchStart - 1, windowLength + 1);
+
+        return result;
+    }
+
+    void expectSwitch(const SwitchMeasurement& result)
+    {
+        logMessage("blocks before rejoining: " + juce::String(result.firstMatchingBlock)
+                   + ", dry while priming: " + juce::String(result.dryBlocks)
+                   + ", max second difference: steady " + juce::String(result.steadyStep, 6)
+                   + ", switch " + juce::String(result.switchStep, 6));
+
+        expect(result.ready, "first design did not finish");
+
+        // 1023 탭은 4096 샘플을 채우므로 한 블록(256)에 다 하지 않고 원신호로 기다려야 함
+        expectGreaterThan(result.dryBlocks, 1, "the new path was primed inside one callback");
+        expect(result.firstMatchingBlock > result.dryBlocks && result.firstMatchingBlock <= 40,
+               "the switched output does not rejoin the reference");
+
+        // 페이드 모서리만 남고 하드 교체 같은 불연속(사인파 진폭 수준)은 없어야 함
+        expectLessThan(result.switchStep, 0.01f, "the switch clicks");
+    }
+
+    static float getMaxDifference(const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b)
+    {
+        float maxDifference = 0.0f;
+        for (int ch = 0; ch < a.getNumChannels(); ++ch)
+            for (int i = 0; i < a.getNumSamples(); ++i)
+                maxDifference = juce::jmax(maxDifference, std::abs(a.getSample(ch, i) - b.getSample(ch, i)));
+
+        return maxDifference;
+    }
+};
+
+static PathSwitchTests pathSwitchTests;
@@ -0,0 +1,238 @@
+/*
+  ==============================================================================
+
+    RealtimeSafetyTests.cpp
+    오디오 스레드 실시간 안전성: 자동화 중 설계를 포함한 블록 처리에 힙 할당/해제가 없음
+    processBlock 전체는 위반 시 abort하는 모드로 돌려 잠금/시스템 호출까지 확인
+    (LOUDNESS_REALTIME_CHECKS로 빌드한 실행 파일에서만 의미 있음)
+
+  ==============================================================================
+*/
+
+#include "TestHelpers.h"
+#include "DSP/RealtimeSafety.h"
+#include "PluginProcessor.h"
+
+class RealtimeSafetyTests : public juce::UnitTest
+{
+public:
+    RealtimeSafetyTests() : juce::UnitTest("Real-time safety", "LoudnessCompensator") {}
+
+    void runTest() override
+    {
+        beginTest("Loudness automation designs on the audio thread without allocating");
+        {
+            expect(RealtimeSafety::isEnabled(), "runner was built without LOUDNESS_REALTIME_CHECKS");
+
+            expectAllocationFree("linear phase", [](LoudnessCompensatorDSP& dsp)
+            {
+                dsp.setFilterTaps(2047);
+            });
+
+            expectAllocationFree("warped", [](LoudnessCompensatorDSP& dsp)
+            {
+                dsp.setFilterEngine(LoudnessCompensatorDSP::FilterEngine::warped);
+            });
+
+            expectAllocationFree("hybrid", [](LoudnessCompensatorDSP& dsp)
+            {
+                dsp.setFilterEngine(LoudnessCompensatorDSP::FilterEngine::hybrid);
+            });
+        }
+
+        beginTest("processBlock under Loudness automation has no violations (abort on violation)");
+        {
+            expectProcessBlockRealtimeSafe();
+        }
+
+        beginTest("Parameter listener called on the audio thread has no violations (abort on violation)");
+        {
+            expectAudioThreadParameterChangesRealtimeSafe();
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 256;
+    static constexpr int automationBlocks = 200;
+
+    using Violation = RealtimeSafety::Violation;
+
+    // 블록마다 Loudness를 움직이며 (설계 해상도보다 크게) 오디오 스레드로 표시한 구간의 할당/해제를 셈
+    // 폴링 콜백이 예약을 넘기고 예비 항목을 새로 만들 수 있도록 블록 사이를 조금 쉼 (실제 블록 간격처럼)
+    template <typename Configure>
+    void expectAllocationFree(const juce::String& name, Configure&& configure)
+    {
+        LoudnessCompensatorDSP dsp;
+        dsp.setProgressiveDesign(false);  // 미리듣기 없이 매번 전체 설계가 오디오 스레드에서
+        configure(dsp);
+        dsp.setEasyLoudness(20.0f);
+        dsp.prepare(sampleRate, blockSize);
+        expect(TestHelpers::waitForFilter(dsp, blockSize), name + ": first design did not finish");
+
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        TestHelpers::SineSource source;
+        source.sampleRate = sampleRate;
+
+        const auto allocationsBefore = RealtimeSafety::getNumViolations(Violation::allocation);
+        const auto deallocationsBefore = RealtimeSafety::getNumViolations(Violation::deallocation);
+        const auto designsBefore = dsp.getDesignExecutionCount();
+
+        for (int block = 0; block < automationBlocks; ++block)
+        {
+            source.fill(buffer);
+
+            {
+                const RealtimeSafety::ScopedAudioThread audioThread;
+                dsp.setEasyLoudness(20.0f + 0.25f * static_cast<float>(block));
+                dsp.process(buffer);
+            }
+
+            juce::Thread::sleep(2);
+        }
+
+        const auto allocations = RealtimeSafety::getNumViolations(Violation::allocation) - allocationsBefore;
+        const auto deallocations = RealtimeSafety::getNumViolations(Violation::deallocation) - deallocationsBefore;
+        const auto designs = dsp.getDesignExecutionCount() - designsBefore;
+
+        logMessage(name + ": " + juce::String(designs) + " designs in " + juce::String(automationBlocks) + " blocks, "
+                   + juce::String(allocations) + " allocations, " + juce::String(deallocations) + " deallocations");
+
+        // 설계가 실제로 오디오 스레드에서 일어났어야 검사가 의미 있음
+        expectGreaterThan(designs, static_cast<juce::int64>(automationBlocks / 10), name + ": automation did not design");
+        expectEquals(allocations, static_cast<juce::int64>(0), name + ": heap allocation on the audio thread");
+        expectEquals(deallocations, static_cast<juce::int64>(0), name + ": heap deallocation on the audio thread");
+    }
+
+    static void setParameter(LoudnessCompensatorAudioProcessor& processor, const char* parameterID, float value)
+    {
+        if (auto* parameter = processor.getValueTreeState().getParameter(parameterID))
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+    }
+
+    // 호스트처럼 파라미터는 오디오 콜백 밖에서 바꾸고, processBlock은 오디오 스레드로 표시한 채 부름
+    // (processBlock도 스스로 표시하지만 호스트 콜백 전체를 감싸는 경우와 같게)
+    // 위반이 하나라도 있으면 그 자리에서 abort하므로 스택이 stderr에 남음
+    void expectProcessBlockRealtimeSafe()
+    {
+        LoudnessCompensatorAudioProcessor processor;
+        setParameter(processor, "easyLoudness", 20.0f);
+        processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        juce::MidiBuffer midi;
+        TestHelpers::SineSource source;
+        source.sampleRate = sampleRate;
+
+        // 첫 설계는 작업 스레드에서 (이 구간은 검사하지 않음)
+        const auto deadline = juce::Time::getMillisecondCounterHiRes() + 30000.0;
+        while (!processor.getDSP().isFilterReady() && juce::Time::getMillisecondCounterHiRes() < deadline)
+        {
+            source.fill(buffer);
+            processor.processBlock(buffer, midi);
+            juce::Thread::sleep(1);
+        }
+
+        expect(processor.getDSP().isFilterReady(), "first design did not finish");
+
+        const auto violationsBefore = RealtimeSafety::getNumViolations();
+        const auto designsBefore = processor.getDSP().getDesignExecutionCount();
+
+        RealtimeSafety::setAbortOnViolation(true);
+
+        for (int block = 0; block < automationBlocks; ++block)
+        {
+            setParameter(processor, "easyLoudness", 20.0f + 0.25f * static_cast<float>(block));
+            source.fill(buffer);
+
+            {
+                const RealtimeSafety::ScopedAudioThread audioThread;
+                processor.processBlock(buffer, midi);
+            }
+
+            juce::Thread::sleep(2);
+        }
+
+        RealtimeSafety::setAbortOnViolation(false);
+
+        const auto violations = RealtimeSafety::getNumViolations() - violationsBefore;
+        const auto designs = processor.getDSP().getDesignExecutionCount() - designsBefore;
+
+        logMessage("processBlock: " + juce::String(designs) + " designs in " + juce::String(automationBlocks) + " blocks, "
+                   + juce::String(violations) + " violations");
+
+        expectGreaterThan(designs, static_cast<juce::int64>(automationBlocks / 10), "processBlock: automation did not design");
+        expectEquals(violations, static_cast<juce::int64>(0), "processBlock: real-time violation on the audio thread");
+
+        processor.releaseResources();
+    }
+
+    // VST3/AU 래퍼는 자동화된 파라미터의 리스너(parameterChanged)를 오디오 스레드에서 부름
+    // 값은 콜백 밖에서 바꾸고, 리스너 호출과 그 값을 적용하는 processBlock을 오디오 스레드로 표시한 채 부름
+    void expectAudioThreadParameterChangesRealtimeSafe()
+    {
+        LoudnessCompensatorAudioProcessor processor;
+        processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        juce::MidiBuffer midi;
+        TestHelpers::SineSource source;
+        source.sampleRate = sampleRate;
+
+        const auto deadline = juce::Time::getMillisecondCounterHiRes() + 30000.0;
+        while (!processor.getDSP().isFilterReady() && juce::Time::getMillisecondCounterHiRes() < deadline)
+        {
+            source.fill(buffer);
+            processor.processBlock(buffer, midi);
+            juce::Thread::sleep(1);
+        }
+
+        expect(processor.getDSP().isFilterReady(), "first design did not finish");
+
+        // 표준 품질 단계 안에서만 (Extreme 단계는 메시지 스레드가 버퍼를 늘림)
+        struct Change { const char* parameterID; float value; };
+        const Change changes[] = { { "kValue", 12.0f }, { "deltaMax", 30.0f }, { "expertMode", 1.0f },
+                                   { "filterTaps", 2.0f }, { "constantLatency", 1.0f }, { "qualityGovernor", 1.0f },
+                                   { "kValue", 25.0f }, { "filterTaps", 3.0f }, { "constantLatency", 0.0f } };
+
+        const auto violationsBefore = RealtimeSafety::getNumViolations();
+        RealtimeSafety::setAbortOnViolation(true);
+
+        for (int block = 0; block < automationBlocks; ++block)
+        {
+            const auto& change = changes[block % static_cast<int>(std::size(changes))];
+            const bool changed = block % 4 == 0;
+
+            if (changed)
+                setParameter(processor, change.parameterID, change.value);
+
+            source.fill(buffer);
+
+            {
+                const RealtimeSafety::ScopedAudioThread audioThread;
+
+                if (changed)
+                    processor.parameterChanged(change.parameterID, change.value);
+
+                processor.processBlock(buffer, midi);
+            }
+
+            juce::Thread::sleep(2);
+        }
+
+        RealtimeSafety::setAbortOnViolation(false);
+
+        const auto violations = RealtimeSafety::getNumViolations() - violationsBefore;
+        logMessage("parameter listener: " + juce::String(violations) + " violations");
+
+        expectEquals(violations, static_cast<juce::int64>(0), "parameter listener: real-time violation on the audio thread");
+        expect(processor.getDSP().isConstantLatency() == (processor.getValueTreeState().getRawParameterValue("constantLatency")->load() > 0.5f),
+               "the last change did not reach the DSP");
+
+        processor.releaseResources();
+    }
+};
+
+static RealtimeSafetyTests realtimeSafetyTests;
@@ -0,0 +1,303 @@
+/*
+  ==============================================================================
+
+    SharedIRStoreTests.cpp
+    같은 설정의 인스턴스들이 설계된 IR 하나를 공유하는지 (100개 인스턴스 메모리 확인)
+
+  ==============================================================================
+*/
+
+#include "TestHelpers.h"
+#include <thread>
+
+class SharedIRStoreTests : public juce::UnitTest
+{
+public:
+    SharedIRStoreTests() : juce::UnitTest("Shared IR store", "LoudnessCompensator") {}
+
+    void runTest() override
+    {
+        juce::SharedResourcePointer<SharedIRStore> store;
+        const int entriesBefore = store->getNumEntries();
+        const size_t bytesBefore = store->getTotalBytes();
+        const auto createdBefore = store->getNumCreated();
+
+        std::vector<std::unique_ptr<LoudnessCompensatorDSP>> instances;
+
+        beginTest("Instances with the same settings design once and borrow one IR");
+        {
+            for (int i = 0; i < numInstances; ++i)
+            {
+                instances.push_back(std::make_unique<LoudnessCompensatorDSP>());
+                instances.back()->setEasyLoudness(50.0f);
+                instances.back()->prepare(sampleRate, blockSize);
+            }
+
+            bool allReady = true;
+            for (auto& instance : instances)
+                allReady = TestHelpers::waitForFilter(*instance, blockSize) && allReady;
+
+            expect(allReady, "first design did not finish");
+
+            const auto first = instances.front()->getCurrentDesign();
+            expect(first != nullptr, "no IR applied");
+
+            int sameIR = 0;
+            for (auto& instance : instances)
+                sameIR += instance->getCurrentDesign() == first ? 1 : 0;
+
+            expectEquals(sameIR, numInstances, "instances hold different IRs for the same key");
+            expectEquals(store->getNumEntries() - entriesBefore, 1, "store holds more than one entry for one key");
+            expectEquals(static_cast<int>(store->getNumCreated() - createdBefore), 1, "the same key was designed more than once");
+
+            if (first != nullptr)
+            {
+                // 공유 IR은 저장소에 한 번만 있고, 인스턴스마다 상주하는 것은 컨볼루션 상태와 arena뿐
+                const auto sharedBytes = static_cast<juce::int64>(store->getTotalBytes() - bytesBefore);
+                expectEquals(sharedBytes, static_cast<juce::int64>(first->getMemoryUsage()), "shared IR bytes are not counted once");
+
+                const auto usage = instances.front()->getMemoryUsage();
+                logMessage(juce::String(numInstances) + " instances: shared IR " + juce::String(sharedBytes / 1024)
+                           + " KiB once, resident " + juce::String(static_cast<int>(usage.getResidentBytes() / 1024)) + " KiB each");
+            }
+        }
+
+        beginTest("The shared IR is released with the last instance");
+        {
+            instances.clear();
+            store->releaseUnused();
+            expectEquals(store->getNumEntries(), entriesBefore, "shared IR outlived its instances");
+        }
+
+        beginTest("The audio thread claims a key without waiting, workers join the claim");
+        {
+            SharedIRStore localStore;
+            FilterDesignKey key;
+            key.targetPhon = 40.0f;
+            key.referencePhon = 60.0f;
+            key.filterTaps = 1;
+            key.sampleRate = sampleRate;
+
+            // 예약은 미리 만들어 넘기고, 예약하면 저장소로 옮겨짐
+            bool claimed = false;
+            auto claim = SharedIRStore::makeClaim();
+            expect(localStore.tryFindOrClaim(key, claim, claimed) == nullptr && claimed, "free key was not claimed");
+            expect(claim == nullptr, "claim was not handed to the store");
+
+            // 만드는 중인 키는 다시 예약되지 않고 기다리지도 않음
+            auto secondClaim = SharedIRStore::makeClaim();
+            expect(localStore.tryFindOrClaim(key, secondClaim, claimed) == nullptr && !claimed, "in-flight key was claimed twice");
+            expect(secondClaim != nullptr, "unused claim was taken");
+
+            // 작업 스레드는 새로 만들지 않고 예약한 쪽의 결과를 기다려 받음
+            bool createdAgain = false;
+            SharedImpulseResponse::Ptr joined;
+            std::thread worker([&]
+            {
+                joined = localStore.findOrCreate(key, [&]() -> SharedImpulseResponse::Ptr
+                {
+                    createdAgain = true;
+                    return nullptr;
+                });
+            });
+
+            while (localStore.getNumJoined() == 0)
+                juce::Thread::sleep(1);
+
+            SharedImpulseResponse::Ptr designed = new SharedImpulseResponse(key, { 1.0f }, 0.0f);
+            localStore.completeClaim(key, designed);
+            worker.join();
+
+            expect(!createdAgain, "worker designed a claimed key");
+            expect(joined == designed, "worker did not receive the claimed result");
+            expect(localStore.tryFind(key) == designed, "claimed result was not stored");
+        }
+
+        beginTest("prepare hands over the audio thread's claim and does not deadlock a job waiting on it");
+        {
+            expectPrepareWithClaimedKey(*store);
+        }
+
+        beginTest("Entering offline rendering does not build the tail on the audio thread");
+        {
+            expectOfflineTailFallback(*store);
+        }
+    }
+
+private:
+    static constexpr int numInstances = 100;
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 256;
+    static constexpr int twoStageBlockSize = 64;  // 오프라인에서 2단으로 나뉘는 파티션 크기
+    static constexpr double timeoutMilliseconds = 10000.0;
+
+    // 폴링 스레드를 이 콜백에 세워 두어 오디오 스레드의 예약이 저장소로 넘어가지 않은 상태를 만듦
+    struct PollerStall
+    {
+        explicit PollerStall(SharedWorkerPool& pool)
+            : client(pool)
+        {
+            client.setPollCallback([this]
+            {
+                if (!holding.load())
+                    return;
+
+                stalled.signal();
+                released.wait(-1);
+            });
+        }
+
+        ~PollerStall() { resume(); }
+
+        bool hold()
+        {
+            stalled.reset();
+            released.reset();
+            holding.store(true);
+            return stalled.wait(static_cast<int>(timeoutMilliseconds));
+        }
+
+        void resume()
+        {
+            holding.store(false);
+            released.signal();
+        }
+
+        std::atomic<bool> holding { false };
+        juce::WaitableEvent stalled, released;
+        SharedWorkerPool::Client client;
+    };
+
+    template <typename Condition>
+    static bool waitUntil(Condition&& condition)
+    {
+        const auto deadline = juce::Time::getMillisecondCounterHiRes() + timeoutMilliseconds;
+
+        while (!condition())
+        {
+            if (juce::Time::getMillisecondCounterHiRes() > deadline)
+                return false;
+
+            juce::Thread::sleep(1);
+        }
+
+        return true;
+    }
+
+    // 오디오 스레드가 새 Loudness를 예약해 바로 설계하고 process를 돌려줄 때까지 블록을 돌림
+    static bool claimOnAudioThread(LoudnessCompensatorDSP& dsp, float loudness)
+    {
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        const auto designsBefore = dsp.getDesignExecutionCount();
+        dsp.setEasyLoudness(loudness);
+
+        for (int block = 0; block < 100 && dsp.getDesignExecutionCount() == designsBefore; ++block)
+        {
+            buffer.clear();
+            dsp.process(buffer);
+        }
+
+        return dsp.getDesignExecutionCount() > designsBefore;
+    }
+
+    // 예약이 넘어가기 전(폴링 간격 안)에 같은 키를 기다리는 작업이 있는 인스턴스를 다시 prepare
+    // 취소가 폴링을 막은 채 기다리면 예약을 넘길 폴링 콜백이 돌지 못해 영원히 멈춤
+    void expectPrepareWithClaimedKey(SharedIRStore& store)
+    {
+        juce::SharedResourcePointer<SharedWorkerPool> pool;
+        PollerStall stall(*pool);
+
+        LoudnessCompensatorDSP waiter, claimer;
+        for (auto* dsp : { &waiter, &claimer })
+        {
+            dsp->setProgressiveDesign(false);
+            dsp->setFilterTaps(1023);
+        }
+
+        // 기다리는 쪽이 폴링 목록에서 먼저 (폴링 스레드가 예약한 쪽보다 먼저 여기서 막히도록)
+        waiter.setEasyLoudness(36.6f);
+        waiter.prepare(sampleRate, blockSize);
+        claimer.setEasyLoudness(33.3f);
+        claimer.prepare(sampleRate, blockSize);
+        expect(TestHelpers::waitForFilter(waiter, blockSize) && TestHelpers::waitForFilter(claimer, blockSize),
+               "first design did not finish");
+
+        expect(stall.hold(), "poller did not stop");
+        expect(claimOnAudioThread(claimer, 47.7f), "audio thread did not design the new key");
+
+        // 같은 키의 백그라운드 설계가 예약을 기다림
+        const auto joinedBefore = store.getNumJoined();
+        waiter.setEasyLoudness(47.7f);
+        waiter.prepare(sampleRate, blockSize);
+        expect(waitUntil([&] { return store.getNumJoined() > joinedBefore; }), "background design did not join the claim");
+
+        std::atomic<bool> prepared { false };
+        std::thread preparing([&]
+        {
+            waiter.prepare(sampleRate, blockSize);
+            prepared.store(true);
+        });
+
+        stall.resume();
+        expect(waitUntil([&] { return prepared.load(); }), "prepare deadlocked on a key claimed by the audio thread");
+        preparing.join();
+
+        // 예약한 인스턴스의 prepare는 작업을 취소하기 전에 스스로 예약을 넘김
+        // (남겨 두면 prepare가 시작한 첫 설계가 폴링을 기다리므로 폴링이 멈춘 동안 끝나지 않음)
+        expect(stall.hold(), "poller did not stop");
+        expect(claimOnAudioThread(claimer, 52.2f), "audio thread did not design the new key");
+        claimer.prepare(sampleRate, blockSize);
+        expect(TestHelpers::waitForFilter(claimer, blockSize, timeoutMilliseconds / 1000.0), "prepare left the audio thread's claim pending");
+        stall.resume();
+    }
+
+    // 작은 블록의 실시간 인스턴스를 오프라인으로 바꾸면 2단 경로의 뒷단 스펙트럼이 필요함
+    // 오디오 스레드는 변환하지 않고(저장소에 새 항목 없음) 앞단에 전체 IR을 두고 이어 가므로
+    // 전환하지 않은 인스턴스와 출력이 같음
+    void expectOfflineTailFallback(SharedIRStore& store)
+    {
+        LoudnessCompensatorDSP switching, realtime;
+        for (auto* dsp : { &switching, &realtime })
+        {
+            dsp->setProgressiveDesign(false);
+            dsp->setFilterTaps(1023);
+            dsp->setEasyLoudness(44.4f);
+            dsp->prepare(sampleRate, twoStageBlockSize);
+        }
+
+        expect(TestHelpers::waitForFilter(switching, twoStageBlockSize) && TestHelpers::waitForFilter(realtime, twoStageBlockSize),
+               "first design did not finish");
+
+        TestHelpers::SineSource source;
+        source.sampleRate = sampleRate;
+        juce::AudioBuffer<float> buffer(2, twoStageBlockSize), reference(2, twoStageBlockSize);
+        float maxDifference = 0.0f;
+        int entriesBefore = 0;
+
+        for (int block = 0; block < 200; ++block)
+        {
+            if (block == 100)
+            {
+                maxDifference = 0.0f;
+                entriesBefore = store.getNumEntries();
+                switching.setNonRealtime(true);
+            }
+
+            source.fill(buffer);
+            reference.makeCopyOf(buffer, true);
+            switching.process(buffer);
+            realtime.process(reference);
+
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                for (int i = 0; i < twoStageBlockSize; ++i)
+                    maxDifference = juce::jmax(maxDifference, std::abs(buffer.getSample(ch, i) - reference.getSample(ch, i)));
+
+            if (block == 100)
+                expectEquals(store.getNumEntries(), entriesBefore, "the audio thread built the tail");
+        }
+
+        expectLessThan(maxDifference, 1.0e-4f, "single-stage fallback changes the output");
+    }
+};
+
+static SharedIRStoreTests sharedIRStoreTests;
@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+
+    StartupBenchmark.cpp
+    인스턴스 생성부터 첫 필터 적용 오디오까지 걸리는 시간 (품질 단계별)
+
+  ==============================================================================
+*/
+
+#include "TestHelpers.h"
+#include "PluginProcessor.h"
+
+class StartupBenchmark : public juce::UnitTest
+{
+public:
+    StartupBenchmark() : juce::UnitTest("Instantiate to first audio", "Benchmarks") {}
+
+    void runTest() override
+    {
+        beginTest("prepareToPlay does not wait for the first design");
+
+        for (int choice = 0; choice < numStandardQualities; ++choice)
+        {
+            const auto deferred = measureBest(choice, false);
+            const auto blocking = measureBest(choice, true);
+
+            logMessage(juce::String((512 << choice) - 1) + " taps: construct " + juce::String(deferred.constructMilliseconds, 2)
+                       + " ms, prepareToPlay " + juce::String(deferred.prepareMilliseconds, 2)
+                       + " ms (blocking design " + juce::String(blocking.prepareMilliseconds, 2)
+                       + " ms), first filtered audio " + juce::String(deferred.firstAudioMilliseconds, 2) + " ms");
+
+            expect(deferred.ready && blocking.ready, "first design did not finish");
+
+            // 짧은 단계는 설계가 잡음 수준이라 가장 긴 표준 단계만 비교
+            if (choice == numStandardQualities - 1)
+                expectLessThan(deferred.prepareMilliseconds, blocking.prepareMilliseconds, "prepareToPlay waits for the design");
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 256;
+    static constexpr int numStandardQualities = 4;  // Low ~ Ultra (Extreme 단계는 설계가 작업 스레드에 나뉨)
+    static constexpr int numRuns = 3;
+
+    struct StartupTiming
+    {
+        double constructMilliseconds = 0.0;
+        double prepareMilliseconds = 0.0;
+        double firstAudioMilliseconds = 0.0;  // 생성부터 필터가 적용된 첫 블록까지
+        bool ready = false;
+    };
+
+    static double now() { return juce::Time::getMillisecondCounterHiRes(); }
+
+    static void setParameter(LoudnessCompensatorAudioProcessor& processor, const char* parameterID, float value)
+    {
+        if (auto* parameter = processor.getValueTreeState().getParameter(parameterID))
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+    }
+
+    // 스레드 시작 지연 등 잡음을 빼려고 여러 번 재서 가장 짧은 값
+    StartupTiming measureBest(int qualityChoice, bool blockingDesign)
+    {
+        StartupTiming best;
+        best.constructMilliseconds = best.prepareMilliseconds = best.firstAudioMilliseconds = 1.0e9;
+        best.ready = true;
+
+        for (int run = 0; run < numRuns; ++run)
+        {
+            // 측정마다 저장소에 없는 Loudness 값 (다른 측정의 설계를 빌려 쓰지 않도록)
+            const float loudness = 21.3f + 11.0f * static_cast<float>(qualityChoice)
+                                 + 0.5f * static_cast<float>(2 * run + (blockingDesign ? 1 : 0));
+            const auto timing = measure(qualityChoice, loudness, blockingDesign);
+
+            best.constructMilliseconds = juce::jmin(best.constructMilliseconds, timing.constructMilliseconds);
+            best.prepareMilliseconds = juce::jmin(best.prepareMilliseconds, timing.prepareMilliseconds);
+            best.firstAudioMilliseconds = juce::jmin(best.firstAudioMilliseconds, timing.firstAudioMilliseconds);
+            best.ready = best.ready && timing.ready;
+        }
+
+        return best;
+    }
+
+    // blockingDesign: prepare 안에서 설계를 끝내는 경로 (오프라인 렌더링, 첫 설계를 미루기 전 동작과 같음)
+    StartupTiming measure(int qualityChoice, float loudness, bool blockingDesign)
+    {
+        StartupTiming timing;
+
+        const auto start = now();
+        auto processor = std::make_unique<LoudnessCompensatorAudioProcessor>();
+        timing.constructMilliseconds = now() - start;
+
+        setParameter(*processor, "filterTaps", static_cast<float>(qualityChoice));
+        setParameter(*processor, "easyLoudness", loudness);
+        processor->setNonRealtime(blockingDesign);
+
+        const auto prepareStart = now();
+        processor->prepareToPlay(sampleRate, blockSize);
+        timing.prepareMilliseconds = now() - prepareStart;
+
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        juce::MidiBuffer midi;
+        TestHelpers::SineSource source;
+        source.sampleRate = sampleRate;
+
+        const auto deadline = now() + 30000.0;
+        while (!processor->getDSP().isFilterReady() && now() < deadline)
+        {
+            source.fill(buffer);
+            processor->processBlock(buffer, midi);
+
+            if (!processor->getDSP().isFilterReady())
+                juce::Thread::sleep(1);
+        }
+
+        timing.firstAudioMilliseconds = now() - start;
+        timing.ready = processor->getDSP().isFilterReady();
+        processor->releaseResources();
+        return timing;
+    }
+};
+
+static StartupBenchmark startupBenchmark;
@@ -0,0 +1,80 @@
+/*
+  ==============================================================================
+
+    TestHelpers.h
+    테스트 공용 도우미 (첫 설계 대기, 신호 생성, 블록 단위 처리)
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "DSP/LoudnessCompensatorDSP.h"
+#include <cmath>
+
+namespace TestHelpers
+{
+    // 첫 설계는 작업 스레드에서 끝나므로 무음 블록을 처리하며 기다림 (시간 안에 안 되면 false)
+    inline bool waitForFilter(LoudnessCompensatorDSP& dsp, int blockSize, double timeoutSeconds = 30.0)
+    {
+        juce::AudioBuffer<float> silence(2, blockSize);
+        const auto deadline = juce::Time::getMillisecondCounterHiRes() + timeoutSeconds * 1000.0;
+
+        while (!dsp.isFilterReady())
+        {
+            if (juce::Time::getMillisecondCounterHiRes() > deadline)
+                return false;
+
+            silence.clear();
+            dsp.process(silence);
+            juce::Thread::sleep(1);
+        }
+
+        return true;
+    }
+
+    // 두 채널에 같은 사인파 (위상은 블록 사이에서 이어짐)
+    struct SineSource
+    {
+        double frequency = 100.0;
+        double sampleRate = 48000.0;
+        float amplitude = 0.25f;
+        juce::int64 position = 0;
+
+        void fill(juce::AudioBuffer<float>& buffer)
+        {
+            const double omega = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+            {
+                const auto sample = amplitude * static_cast<float>(std::sin(omega * static_cast<double>(position + i)));
+
+                for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                    buffer.setSample(ch, i, sample);
+            }
+
+            position += buffer.getNumSamples();
+        }
+    };
+
+    inline float getRMS(const float* samples, int numSamples)
+    {
+        double sum = 0.0;
+        for (int i = 0; i < numSamples; ++i)
+            sum += static_cast<double>(samples[i]) * samples[i];
+
+        return numSamples > 0 ? static_cast<float>(std::sqrt(sum / numSamples)) : 0.0f;
+    }
+
+    // 이웃 샘플과의 2차 차분 최댓값: 부드러운 저역 사인파에서는 아주 작고, 불연속(클릭)이 있으면 튐
+    inline float getMaxSecondDifference(const float* samples, int numSamples)
+    {
+        float maxStep = 0.0f;
+        for (int i = 1; i + 1 < numSamples; ++i)
+            maxStep = juce::jmax(maxStep, std::abs(samples[i + 1] - 2.0f * samples[i] + samples[i - 1]));
+
+        return maxStep;
+    }
+}
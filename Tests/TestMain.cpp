@@ -0,0 +1,31 @@
+/*
+  ==============================================================================
+
+    TestMain.cpp
+    단위 테스트/벤치마크 실행 (인자로 카테고리를 주면 그 카테고리만)
+
+  ==============================================================================
+*/
+
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+
+int main(int argc, char* argv[])
+{
+    // 프로세서의 파라미터 트리/타이머가 메시지 매니저를 쓰므로 GUI 쪽까지 초기화 (창은 만들지 않음)
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::UnitTestRunner runner;
+    runner.setAssertOnFailure(false);
+
+    if (argc > 1)
+        runner.runTestsInCategory(argv[1]);
+    else
+        runner.runAllTests();
+
+    int failures = 0;
+    for (int i = 0; i < runner.getNumResults(); ++i)
+        failures += runner.getResult(i)->failures;
+
+    return failures > 0 ? 1 : 0;
+}
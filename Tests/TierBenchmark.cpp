@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+    TierBenchmark.cpp
+    품질 단계(Low ~ Extreme)와 샘플레이트별 설계 시간과 실시간 CPU
+
+  ==============================================================================
+*/
+
+#include "TestHelpers.h"
+
+class TierBenchmark : public juce::UnitTest
+{
+public:
+    TierBenchmark() : juce::UnitTest("Quality tiers across sample rates", "Benchmarks") {}
+
+    void runTest() override
+    {
+        for (const double sampleRate : { 48000.0, 96000.0, 192000.0 })
+        {
+            beginTest(juce::String(sampleRate / 1000.0, 0) + " kHz");
+
+            for (int tier = 0; tier < numTiers; ++tier)
+            {
+                const int taps = (512 << tier) - 1;
+                const auto result = measureTier(sampleRate, taps);
+                const double blockMicroseconds = 1.0e6 * blockSize / sampleRate;
+
+                logMessage(juce::String(taps) + " taps: first design " + juce::String(result.designMilliseconds, 1)
+                           + " ms, redesign " + juce::String(result.redesignMilliseconds, 1)
+                           + " ms, " + juce::String(result.microsecondsPerBlock, 1) + " us per " + juce::String(blockSize)
+                           + " stereo samples (" + juce::String(100.0 * result.microsecondsPerBlock / blockMicroseconds, 1)
+                           + " % of realtime), worst block while redesigning " + juce::String(result.worstRedesignBlockMicroseconds, 1) + " us");
+
+                expect(result.ready, juce::String(taps) + " taps: first design did not finish");
+                expect(result.redesigned, juce::String(taps) + " taps: redesign did not finish");
+                expectLessThan(result.microsecondsPerBlock, blockMicroseconds, juce::String(taps) + " taps do not run in realtime");
+            }
+        }
+    }
+
+private:
+    static constexpr int blockSize = 256;
+    static constexpr int numTiers = 8;  // Low (511) ~ Extreme (65535)
+    static constexpr int cpuBlocks = 2000;
+    static constexpr float redesignLoudness = 60.0f;
+
+    struct TierMeasurement
+    {
+        bool ready = false;
+        bool redesigned = false;
+        double designMilliseconds = 0.0;             // prepare부터 첫 필터 적용까지
+        double redesignMilliseconds = 0.0;           // Loudness 변경부터 새 필터 적용까지
+        double worstRedesignBlockMicroseconds = 0.0; // 재설계를 기다리는 동안 가장 오래 걸린 블록 (오디오 스레드 설계 포함)
+        double microsecondsPerBlock = 0.0;           // 정상 상태 스테레오 잡음 처리
+    };
+
+    static double now() { return juce::Time::getMillisecondCounterHiRes(); }
+
+    TierMeasurement measureTier(double sampleRate, int taps)
+    {
+        TierMeasurement result;
+
+        // 미리듣기 필터가 아니라 전체 설계를 잼
+        LoudnessCompensatorDSP dsp;
+        dsp.setProgressiveDesign(false);
+        dsp.setFilterTaps(taps);
+        dsp.setEasyLoudness(40.0f);
+
+        const auto start = now();
+        dsp.prepare(sampleRate, blockSize);
+        result.ready = TestHelpers::waitForFilter(dsp, blockSize);
+        result.designMilliseconds = now() - start;
+
+        juce::Random random(1);
+        juce::AudioBuffer<float> input(2, blockSize), buffer(2, blockSize);
+        for (int ch = 0; ch < input.getNumChannels(); ++ch)
+            for (int i = 0; i < blockSize; ++i)
+                input.setSample(ch, i, 0.1f * (random.nextFloat() * 2.0f - 1.0f));
+
+        double elapsed = 0.0;
+        for (int block = -50; block < cpuBlocks; ++block)
+        {
+            buffer.makeCopyOf(input, true);
+
+            const auto blockStart = now();
+            dsp.process(buffer);
+
+            if (block >= 0)
+                elapsed += now() - blockStart;
+        }
+
+        result.microsecondsPerBlock = elapsed * 1000.0 / cpuBlocks;
+
+        // 저장소에 없는 Loudness로 바꾸고 새 필터가 적용될 때까지 블록마다 처리 시간을 잼
+        const auto redesignStart = now();
+        const auto deadline = redesignStart + 30000.0;
+        dsp.setEasyLoudness(redesignLoudness);
+
+        while (now() < deadline)
+        {
+            buffer.makeCopyOf(input, true);
+
+            const auto blockStart = now();
+            dsp.process(buffer);
+            result.worstRedesignBlockMicroseconds = juce::jmax(result.worstRedesignBlockMicroseconds, (now() - blockStart) * 1000.0);
+
+            const auto design = dsp.getCurrentDesign();
+            if (design != nullptr && design->key.filterTaps == taps && design->key.targetPhon == dsp.getTargetPhon())
+            {
+                result.redesigned = true;
+                break;
+            }
+
+            juce::Thread::sleep(1);
+        }
+
+        result.redesignMilliseconds = now() - redesignStart;
+        return result;
+    }
+};
+
+static TierBenchmark tierBenchmark;